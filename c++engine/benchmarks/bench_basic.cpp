@@ -1,11 +1,40 @@
 #include "core/bitboard.h"
 #include "core/move.h"
 #include "core/zobrist.h"
+#include "core/legal_mask_table.h"
+#include "core/move_generator.h"
+#include "core/board_batch.h"
+#include "core/hex_board.h"
+#include "core/notation.h"
+#include "ai/minimax.h"
+#include "ai/mcts.h"
 #include <iostream>
 #include <chrono>
+#include <random>
+#include <vector>
+#include <unordered_set>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <algorithm>
 
 using namespace hexuki;
 
+// ============================================================================
+// Allocation counting (replaces global operator new for this binary only)
+// ============================================================================
+
+static size_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+    g_allocations++;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
 void benchmarkMoveGeneration() {
     HexukiBitboard board;
 
@@ -22,10 +51,241 @@ void benchmarkMoveGeneration() {
 
     double movesPerSec = (iterations * 1000.0) / duration.count();
 
+    // Same thing through the stack-resident MoveList
+    MoveList moveList;
+    auto listStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        board.generateMoves(moveList);
+    }
+    auto listEnd = std::chrono::high_resolution_clock::now();
+    double listMs = std::chrono::duration<double, std::milli>(listEnd - listStart).count();
+
     std::cout << "Move generation benchmark:\n";
     std::cout << "  Iterations: " << iterations << "\n";
     std::cout << "  Time: " << duration.count() << " ms\n";
-    std::cout << "  Rate: " << (int)movesPerSec << " generations/sec\n\n";
+    std::cout << "  Rate: " << (int)movesPerSec << " generations/sec\n";
+    std::cout << "  MoveList rate: " << (long long)(iterations * 1000.0 / listMs) << " generations/sec"
+              << " (" << moveList.size() << " moves)\n\n";
+}
+
+void benchmarkRandomPlayouts() {
+    const int playouts = 100000;
+    std::mt19937 rng(12345);
+    int checksum = 0;
+
+    // Materialize every position's move list, then index it
+    auto listStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < playouts; i++) {
+        HexukiBitboard board;
+        MoveList moves;
+        while (true) {
+            board.generateMoves(moves);
+            if (moves.empty()) break;
+            std::uniform_int_distribution<size_t> dist(0, moves.size() - 1);
+            board.makeMove(moves[dist(rng)]);
+        }
+        checksum += board.getScore(PLAYER_1);
+    }
+    auto listEnd = std::chrono::high_resolution_clock::now();
+
+    // Sample one index straight from the masks
+    auto lazyStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < playouts; i++) {
+        HexukiBitboard board;
+        while (true) {
+            MoveGenerator moves(board);
+            if (moves.empty()) break;
+            board.makeMove(moves.random(rng));
+        }
+        checksum += board.getScore(PLAYER_1);
+    }
+    auto lazyEnd = std::chrono::high_resolution_clock::now();
+
+    double listMs = std::chrono::duration<double, std::milli>(listEnd - listStart).count();
+    double lazyMs = std::chrono::duration<double, std::milli>(lazyEnd - lazyStart).count();
+
+    std::cout << "Random playout benchmark (" << playouts << " playouts):\n";
+    std::cout << "  MoveList + index:   " << (long long)(playouts * 1000.0 / listMs) << " playouts/sec\n";
+    std::cout << "  MoveGenerator:      " << (long long)(playouts * 1000.0 / lazyMs) << " playouts/sec\n";
+    std::cout << "  Speedup: " << listMs / lazyMs << "x (checksum " << checksum << ")\n\n";
+}
+
+template <int Radius>
+double timeHexBoardPlayouts(int playouts, int64_t& checksum) {
+    std::mt19937 rng(12345);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < playouts; i++) {
+        HexBoard<Radius> board;
+        board.playout(rng);
+        checksum += board.getScore(PLAYER_1);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return playouts * 1000.0 / std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void benchmarkBoardSizes() {
+    // Generic board by radius (19-hex = same game as HexukiBitboard's fast path)
+    const int playouts = 20000;
+    int64_t checksum = 0;
+
+    std::cout << "Board size benchmark (" << playouts << " HexBoard playouts each):\n";
+    std::cout << "  19 hexes: " << (long long)timeHexBoardPlayouts<2>(playouts, checksum) << " playouts/sec\n";
+    std::cout << "  37 hexes: " << (long long)timeHexBoardPlayouts<3>(playouts, checksum) << " playouts/sec\n";
+    std::cout << "  61 hexes: " << (long long)timeHexBoardPlayouts<4>(playouts, checksum) << " playouts/sec\n";
+    std::cout << "  (checksum " << checksum << ")\n\n";
+}
+
+template <int Width>
+double timeBatchPlayouts(const HexukiBitboard& board, int playouts, bool scalar, double& checksum) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int done = 0; done < playouts; done += Width) {
+        BoardBatch<Width> batch;
+        batch.load(board, static_cast<uint32_t>(done + 1));
+        if (scalar) batch.playoutScalar(); else batch.playout();
+        checksum += batch.evaluateTerminal();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return playouts * 1000.0 / std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void benchmarkBatchPlayouts() {
+    // Rollouts/sec from the start position: scalar board vs SoA batches
+    const int playouts = 256000;
+    HexukiBitboard start;
+    std::mt19937 rng(99);
+    double checksum = 0.0;
+
+    auto scalarStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < playouts; i++) {
+        HexukiBitboard board = start;
+        while (true) {
+            MoveGenerator moves(board);
+            if (moves.empty()) break;
+            board.makeMove(moves.random(rng));
+        }
+        checksum += board.getScore(PLAYER_1) > board.getScore(PLAYER_2) ? 1.0 : 0.0;
+    }
+    auto scalarEnd = std::chrono::high_resolution_clock::now();
+    double boardRate = playouts * 1000.0 / std::chrono::duration<double, std::milli>(scalarEnd - scalarStart).count();
+
+    std::cout << "Batched playout benchmark (" << playouts << " rollouts, "
+              << (BoardBatch<8>::hasSimdKernel() ? "AVX2" : "no AVX2") << "):\n";
+    std::cout << "  HexukiBitboard:        " << (long long)boardRate << " rollouts/sec\n";
+    std::cout << "  BoardBatch<8> scalar:  " << (long long)timeBatchPlayouts<8>(start, playouts, true, checksum) << " rollouts/sec\n";
+    std::cout << "  BoardBatch<8>:         " << (long long)timeBatchPlayouts<8>(start, playouts, false, checksum) << " rollouts/sec\n";
+    std::cout << "  BoardBatch<16>:        " << (long long)timeBatchPlayouts<16>(start, playouts, false, checksum) << " rollouts/sec\n";
+    double wideRate = timeBatchPlayouts<32>(start, playouts, false, checksum);
+    std::cout << "  BoardBatch<32>:        " << (long long)wideRate << " rollouts/sec"
+              << " (" << wideRate / boardRate << "x, checksum " << checksum << ")\n";
+
+    // MCTS with one rollout per leaf (played out / stopped once decided)
+    // vs 32 per leaf (same rollout budget)
+    mcts::MCTS engine;
+    const char* mctsLabels[] = {"  MCTS 1 playout/leaf, full:    ", "  MCTS 1 playout/leaf, decided: ", "  MCTS 32 playouts/leaf:        "};
+    for (int setup = 0; setup < 3; setup++) {
+        mcts::MCTSConfig config;
+        config.useTimeLimit = false;
+        config.numSimulations = 64000;
+        config.playoutsPerLeaf = (setup == 2) ? 32 : 1;
+        config.stopDecidedRollouts = setup > 0;
+        HexukiBitboard board;
+        mcts::MCTSResult result = engine.findBestMove(board, config);
+        std::cout << mctsLabels[setup] << (long long)(result.simulations * 1000.0 / result.timeMs) << " rollouts/sec\n";
+    }
+
+    // Minimax rollouts: the last 7 empty hexes solved for the outcome
+    mcts::MCTSConfig solvedConfig;
+    solvedConfig.useTimeLimit = false;
+    solvedConfig.numSimulations = 4000;
+    solvedConfig.useMinimaxRollouts = true;
+    solvedConfig.minimaxThreshold = 7;
+    mcts::MCTS solvedEngine;
+    HexukiBitboard midgame;
+    std::mt19937 midgameRng(2024);
+    for (int ply = 0; ply < 6; ply++) {
+        MoveList moves;
+        midgame.generateMoves(moves);
+        midgame.makeMove(moves[midgameRng() % moves.size()]);
+    }
+    mcts::MCTSResult solved = solvedEngine.findBestMove(midgame, solvedConfig);
+    std::cout << "  MCTS minimax rollouts (7): " << (long long)(solved.simulations * 1000.0 / solved.timeMs) << " rollouts/sec\n";
+    std::cout << "\n";
+}
+
+void collectPositions(HexukiBitboard& board, int depth,
+                      std::unordered_set<uint64_t>& raw, std::unordered_set<uint64_t>& canonical) {
+    raw.insert(board.getHash());
+    canonical.insert(board.getCanonicalHash());
+    if (depth == 0) return;
+
+    MoveList moves;
+    board.generateMoves(moves);
+    for (const auto& move : moves) {
+        board.makeMove(move);
+        collectPositions(board, depth - 1, raw, canonical);
+        board.unmakeMove();
+    }
+}
+
+void benchmarkCanonicalKeys() {
+    // Distinct positions within 3 plies of the start, keyed both ways
+    HexukiBitboard board;
+    std::unordered_set<uint64_t> raw;
+    std::unordered_set<uint64_t> canonical;
+    collectPositions(board, 3, raw, canonical);
+
+    std::cout << "Canonical key benchmark (positions within 3 plies):\n";
+    std::cout << "  Raw keys:       " << raw.size() << "\n";
+    std::cout << "  Canonical keys: " << canonical.size()
+              << " (" << (double)raw.size() / canonical.size() << "x fewer)\n\n";
+}
+
+void benchmarkPositionEncoding() {
+    // Round-trip a midgame position through both formats
+    HexukiBitboard board;
+    board.loadPosition("h9:1,h4:5,h6:3,h7:8,h11:2,h12:9|p1:1,2,4,6|p2:1,3,4,5,7|turn:1");
+    const int iterations = 100000;
+    int checksum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        HexukiBitboard copy;
+        copy.loadPosition(board.savePosition());
+        checksum += copy.getScore(PLAYER_1);
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        HexukiBitboard copy;
+        copy.unpack(board.pack());
+        checksum += copy.getScore(PLAYER_1);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto textUs = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+    auto packedUs = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+
+    std::cout << "Position encoding benchmark (save + load round trips):\n";
+    std::cout << "  Text:   " << board.savePosition().size() << " bytes, "
+              << (textUs * 1000.0) / iterations << " ns/round trip\n";
+    std::cout << "  Packed: " << sizeof(PackedPosition) << " bytes, "
+              << (packedUs * 1000.0) / iterations << " ns/round trip\n";
+
+    // Bulk: one buffer of newline-separated positions
+    std::string buffer;
+    for (int i = 0; i < iterations; i++) {
+        buffer += board.savePosition();
+        buffer += '\n';
+    }
+    std::vector<PackedPosition> positions;
+    positions.reserve(iterations);
+    auto bulkStart = std::chrono::high_resolution_clock::now();
+    size_t parsed = parsePositions(buffer, positions);
+    auto bulkEnd = std::chrono::high_resolution_clock::now();
+    auto bulkUs = std::chrono::duration_cast<std::chrono::microseconds>(bulkEnd - bulkStart).count();
+
+    std::cout << "  Bulk:   " << parsed << " lines parsed, "
+              << (bulkUs * 1000.0) / iterations << " ns/line\n";
+    std::cout << "  (checksum " << checksum << ")\n\n";
 }
 
 void benchmarkMakingMoves() {
@@ -37,7 +297,7 @@ void benchmarkMakingMoves() {
         auto moves = board.getValidMoves();
 
         // Make 5 moves
-        for (int j = 0; j < 5 && j < moves.size(); j++) {
+        for (size_t j = 0; j < 5 && j < moves.size(); j++) {
             board.makeMove(moves[j]);
         }
     }
@@ -53,6 +313,183 @@ void benchmarkMakingMoves() {
     std::cout << "  Rate: " << (int)gamesPerSec << " sequences/sec\n\n";
 }
 
+void benchmarkLegalHexMask() {
+    // Build table (timed separately - this is the one-off startup cost)
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    LegalMaskTable::initialize();
+    auto buildEnd = std::chrono::high_resolution_clock::now();
+    auto buildMs = std::chrono::duration_cast<std::chrono::milliseconds>(buildEnd - buildStart).count();
+
+    // Sample occupancies from random games so both paths see realistic positions
+    std::mt19937 rng(42);
+    std::vector<uint32_t> occupancies;
+    for (int game = 0; game < 1000; game++) {
+        HexukiBitboard board;
+        while (!board.isGameOver()) {
+            auto moves = board.getValidMoves();
+            if (moves.empty()) break;
+            board.makeMove(moves[rng() % moves.size()]);
+
+            uint32_t occ = 0;
+            for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+                if (board.isHexOccupied(hexId)) occ |= (1u << hexId);
+            }
+            occupancies.push_back(occ);
+        }
+    }
+
+    int passes = 100;
+    uint32_t checksum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (uint32_t occ : occupancies) checksum += LegalMaskTable::computeLegalHexMask(occ);
+    }
+    auto mid = std::chrono::high_resolution_clock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (uint32_t occ : occupancies) checksum -= LegalMaskTable::lookup(occ);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double ruleMs = std::chrono::duration<double, std::milli>(mid - start).count();
+    double tableMs = std::chrono::duration<double, std::milli>(end - mid).count();
+    double lookups = double(passes) * occupancies.size();
+
+    std::cout << "Legal hex mask benchmark:\n";
+    std::cout << "  Table build: " << buildMs << " ms\n";
+    std::cout << "  Positions: " << occupancies.size() << " x " << passes << " passes\n";
+    std::cout << "  Rule walk: " << (long long)(lookups * 1000.0 / ruleMs) << " masks/sec\n";
+    std::cout << "  Table:     " << (long long)(lookups * 1000.0 / tableMs) << " masks/sec\n";
+    std::cout << "  Speedup:   " << (ruleMs / tableMs) << "x"
+              << (checksum == 0 ? "" : " (MISMATCH!)") << "\n\n";
+}
+
+void benchmarkMoveOrdering() {
+    // Endgame suite (9 empty hexes, solved): static ordering vs killer/history/countermove,
+    // then with enhanced transposition cutoffs, without score-bound cutoffs and
+    // without the endgame kernel
+    std::vector<HexukiBitboard> suite;
+    std::mt19937 rng(2024);
+    for (int game = 0; game < 4; game++) {
+        HexukiBitboard board;
+        for (int ply = 0; ply < 9; ply++) {
+            MoveList moves;
+            board.generateMoves(moves);
+            board.makeMove(moves[rng() % moves.size()]);
+        }
+        suite.push_back(board);
+    }
+
+    std::cout << "Move ordering benchmark (" << suite.size() << " endgames solved):\n";
+    const char* labels[] = {"Static ordering:            ", "Killer/history/countermove: ", "  + enhanced TT cutoffs:    ",
+                            "  - score-bound cutoffs:    ", "  - endgame kernel:         "};
+    for (int setup = 0; setup < 5; setup++) {
+        long long nodes = 0;
+        long long cutoffs = 0;
+        long long firstMoveCutoffs = 0;
+        double ms = 0.0;
+        for (HexukiBitboard board : suite) {
+            minimax::TranspositionTable tt(64);
+            minimax::SearchConfig config;
+            config.maxDepth = MAX_PLIES;
+            config.timeLimitMs = 600000;
+            config.useSearchHeuristics = setup > 0;
+            config.useEnhancedTranspositionCutoffs = setup == 2;
+            config.useScoreBounds = setup != 3;
+            if (setup == 4) config.endgamePlies = 0;
+            config.tt = &tt;
+            auto result = minimax::findBestMove(board, config);
+            nodes += result.nodesSearched;
+            cutoffs += result.cutoffs;
+            firstMoveCutoffs += result.firstMoveCutoffs;
+            ms += result.timeMs;
+        }
+        std::cout << "  " << labels[setup]
+                  << nodes << " nodes, " << ms << " ms (" << (long long)(nodes / ms) << "k nodes/sec), first-move cutoffs "
+                  << (cutoffs ? 100.0 * firstMoveCutoffs / cutoffs : 0.0) << "%\n";
+    }
+    std::cout << "\n";
+}
+
+void benchmarkLazySmp() {
+    // Endgame solve (11 empty hexes, searched to the end) at 1..N threads
+    HexukiBitboard board;
+    board.loadPosition("h9:1,h6:5,h7:4,h4:3,h11:2,h12:6|p1:1,2,4,7,8,9|p2:1,3,5,7,8,9|turn:1");
+    board.makeMove(Move(1, 7));
+    board.makeMove(Move(14, 9));
+
+    int maxThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "Lazy SMP benchmark (endgame solve, " << maxThreads << " hardware threads):\n";
+    double baseMs = 0.0;
+    for (int threads : threadCounts) {
+        minimax::TranspositionTable tt(64);
+        minimax::SearchConfig config;
+        config.maxDepth = MAX_PLIES;
+        config.timeLimitMs = 600000;
+        config.threads = threads;
+        config.tt = &tt;
+        auto result = minimax::findBestMove(board, config);
+        if (threads == 1) baseMs = result.timeMs;
+        std::cout << "  " << threads << " thread(s): " << result.timeMs << " ms, "
+                  << result.nodesSearched << " nodes, score " << result.score
+                  << ", speedup " << baseMs / result.timeMs << "x\n";
+    }
+    std::cout << "\n";
+}
+
+void benchmarkAllocations() {
+    std::cout << "Allocation benchmark:\n";
+
+    // Move generation: std::vector vs MoveList
+    HexukiBitboard board;
+    MoveList moveList;
+    size_t before = g_allocations;
+    auto moves = board.getValidMoves();
+    size_t vectorAllocs = g_allocations - before;
+    before = g_allocations;
+    board.generateMoves(moveList);
+    size_t listAllocs = g_allocations - before;
+    std::cout << "  getValidMoves(): " << vectorAllocs << " allocs/call, generateMoves(MoveList&): "
+              << listAllocs << " allocs/call\n";
+
+    // Position/move parsing (text already in memory)
+    const std::string positionText = "h9:1,h6:5,h7:4,h4:3|p1:1,2,7,8,9|p2:1,3,5,8,9|turn:1";
+    before = g_allocations;
+    board.loadPosition(positionText);
+    size_t loadAllocs = g_allocations - before;
+    before = g_allocations;
+    Move parsedMove;
+    parseMove("h6t5", parsedMove);
+    size_t moveAllocs = g_allocations - before;
+    std::cout << "  loadPosition(): " << loadAllocs << " allocs/call, parseMove(): "
+              << moveAllocs << " allocs/call\n";
+    board.reset();
+
+    // MCTS: allocations per simulation (random rollouts)
+    mcts::MCTS engine;
+    before = g_allocations;
+    auto mctsResult = engine.findBestMove(board, 20000);
+    size_t mctsAllocs = g_allocations - before;
+    std::cout << "  MCTS: " << mctsResult.simulations << " simulations, "
+              << (double)mctsAllocs / mctsResult.simulations << " allocs/simulation\n";
+
+    // Minimax: allocations per searched node (fixed-depth search from a mid-game position)
+    HexukiBitboard midgame;
+    midgame.loadPosition("h9:1,h6:5,h7:4,h4:3,h11:2,h12:6|p1:1,2,4,7,8,9|p2:1,3,5,7,8,9|turn:1");
+    minimax::SearchConfig config;
+    config.maxDepth = 4;
+    config.ttSizeMB = 16;
+    before = g_allocations;
+    auto searchResult = minimax::findBestMove(midgame, config);
+    size_t searchAllocs = g_allocations - before;
+    std::cout << "  Minimax: " << searchResult.nodesSearched << " nodes, "
+              << (double)searchAllocs / searchResult.nodesSearched << " allocs/node\n\n";
+}
+
 int main() {
     std::cout << "===========================================\n";
     std::cout << "HEXUKI C++ ENGINE - Performance Benchmarks\n";
@@ -60,8 +497,17 @@ int main() {
 
     Zobrist::initialize();
 
+    benchmarkLegalHexMask();
     benchmarkMoveGeneration();
+    benchmarkRandomPlayouts();
+    benchmarkBoardSizes();
+    benchmarkCanonicalKeys();
+    benchmarkBatchPlayouts();
     benchmarkMakingMoves();
+    benchmarkPositionEncoding();
+    benchmarkAllocations();
+    benchmarkMoveOrdering();
+    benchmarkLazySmp();
 
     std::cout << "===========================================\n";
     std::cout << "Benchmarks complete\n";
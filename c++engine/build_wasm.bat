@@ -33,11 +33,19 @@ emcc ^
   -std=c++17 ^
   -I include ^
   src/core/bitboard.cpp ^
+  src/core/board_batch.cpp ^
+  src/core/hex_board.cpp ^
+  src/core/legal_mask_table.cpp ^
   src/core/move.cpp ^
+  src/core/notation.cpp ^
+  src/core/packed_position.cpp ^
+  src/core/rule_variants.cpp ^
+  src/core/score_bounds.cpp ^
   src/core/zobrist.cpp ^
   src/ai/mcts.cpp ^
   src/ai/mcts_node.cpp ^
   src/ai/minimax.cpp ^
+  src/ai/transposition_table.cpp ^
   src/wasm_interface.cpp ^
   -s WASM=1 ^
   -s ALLOW_MEMORY_GROWTH=1 ^
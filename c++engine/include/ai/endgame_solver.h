@@ -0,0 +1,226 @@
+#ifndef HEXUKI_ENDGAME_SOLVER_H
+#define HEXUKI_ENDGAME_SOLVER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include "core/bitboard.h"
+#include "core/rules.h"
+#include "core/score_bounds.h"
+#include "utils/constants.h"
+#include "utils/timer.h"
+
+namespace hexuki {
+namespace minimax {
+
+constexpr int ENDGAME_MAX_PLIES = 8;         // Deepest kernel instantiation (empty hexes)
+constexpr int ENDGAME_BOUNDS_MIN_PLIES = 3;  // ScoreBounds cutoffs from this many plies left
+
+/**
+ * Endgame position for the exact solver kernel
+ *
+ * Just what the last plies need: occupancy, tiles on the board, chain
+ * products and totals, both hands and the anti-symmetry bookkeeping. No
+ * hashes, no undo stack: the kernel copies it for each child (about 100
+ * bytes) instead of making and unmaking moves.
+ */
+struct EndgameBoard {
+    uint32_t occupied;
+    uint32_t mirrorMismatch;
+    int32_t chainProducts[2][CHAINS_PER_PLAYER];  // [player - 1][chain], as on HexukiBitboard
+    int32_t scores[2];
+    uint64_t tiles[2];  // Packed inventories [player - 1]
+    uint8_t values[NUM_HEXES];
+    uint8_t side;       // Side to move (player - 1)
+    bool antiSymmetry;  // Anti-symmetry rule in force (see isAntiSymmetryActive)
+
+    explicit EndgameBoard(const HexukiBitboard& board)
+        : occupied(board.getOccupiedMask())
+        , mirrorMismatch(board.getMirrorMismatch())
+        , side(static_cast<uint8_t>(board.getCurrentPlayer() - 1))
+        // Only the first placements can still be exempt; every endgame is past them
+        , antiSymmetry(board.isAntiSymmetryActive()) {
+        for (int p = 0; p < 2; p++) {
+            for (int c = 0; c < CHAINS_PER_PLAYER; c++) chainProducts[p][c] = board.getChainProduct(p + 1, c);
+            scores[p] = board.getScore(p + 1);
+            tiles[p] = board.getTileInventory(p + 1);
+        }
+        for (int hexId = 0; hexId < NUM_HEXES; hexId++) values[hexId] = static_cast<uint8_t>(board.getTileValue(hexId));
+    }
+
+    int emptyHexes() const { return NUM_HEXES - BitOps::popcount(occupied); }
+
+    // Current margin for the side to move
+    int margin() const { return scores[side] - scores[side ^ 1]; }
+
+    // Margin for the side to move once it has played tileValue on hexId (the
+    // move only scales the one chain of each player through that hex)
+    int marginAfter(int hexId, int tileValue) const {
+        int own = chainProducts[side][HEX_SCORING_CHAINS[hexId][side]];
+        int other = chainProducts[side ^ 1][HEX_SCORING_CHAINS[hexId][side ^ 1]];
+        return margin() + (own - other) * (tileValue - 1);
+    }
+
+    ScoreBounds scoreBounds() const {
+        return ScoreBounds::compute(chainProducts, scores, occupied, tiles[0], tiles[1]);
+    }
+
+    // Legal hexes for the side to move (same rules as MoveGenerator), and the
+    // one move the anti-symmetry rule may remove from them (hex -1 if none)
+    template <typename R>
+    uint32_t legalHexes(int& excludedHex, int& excludedSlot) const {
+        uint32_t hexes = R::legalHexMask(occupied);
+        excludedHex = -1;
+        excludedSlot = -1;
+        if constexpr (R::ANTI_SYMMETRY) {
+            if (antiSymmetry) {
+                uint32_t emptySide = mirrorMismatch & hexes;
+                if (mirrorMismatch == 0) {
+                    hexes &= ~CENTER_COLUMN_MASK;
+                } else if (BitOps::popcount(mirrorMismatch) == 2 && emptySide) {
+                    int hexId = BitOps::countTrailingZeros(emptySide);
+                    excludedHex = hexId;
+                    excludedSlot = TILE_SLOTS[values[VERTICAL_MIRROR_PAIRS[hexId]]];
+                }
+            }
+        }
+        return hexes;
+    }
+
+    // Play the tile in TILE_VALUES slot on hexId for the side to move
+    void play(int hexId, int slot) {
+        int tileValue = TILE_VALUES[slot];
+        occupied |= 1u << hexId;
+        values[hexId] = static_cast<uint8_t>(tileValue);
+        for (int p = 0; p < 2; p++) {
+            int32_t& product = chainProducts[p][HEX_SCORING_CHAINS[hexId][p]];
+            scores[p] += product * (tileValue - 1);
+            product *= tileValue;
+        }
+        tiles[side] -= 1ull << (slot * TILE_COUNT_BITS);
+        if (antiSymmetry) {
+            uint32_t pair = mirrorPairMask(hexId);
+            if (values[hexId] != values[VERTICAL_MIRROR_PAIRS[hexId]]) {
+                mirrorMismatch |= pair;
+            } else {
+                mirrorMismatch &= ~pair;
+            }
+        }
+        side ^= 1;
+    }
+};
+
+/**
+ * Exact endgame kernel: negamax alpha-beta over the last Plies empty hexes
+ * (fail-soft, margin for the side to move), unrolled at compile time
+ *
+ * No TT, no move lists, no ordering tables: moves come straight from the
+ * legal hex mask and the held tiles (largest tiles first), each child is a
+ * copy of the parent, and the last ply scores its moves in place with
+ * marginAfter(). Every node visited (last-ply moves included) adds one to
+ * nodesSearched.
+ */
+template <int Plies, typename R>
+int solveEndgameWith(const EndgameBoard& board, int alpha, int beta, int64_t& nodesSearched, R rules) {
+    (void)rules;  // Only passed down; the policy is R
+    nodesSearched++;
+    if constexpr (Plies == 0) {
+        return board.margin();
+    } else {
+        int excludedHex;
+        int excludedSlot;
+        uint32_t hexes = board.template legalHexes<R>(excludedHex, excludedSlot);
+        uint64_t held = tilePresence(board.tiles[board.side]);
+        if (hexes == 0 || held == 0) return board.margin();  // No moves: the game ends here
+
+        if constexpr (Plies >= ENDGAME_BOUNDS_MIN_PLIES) {
+            ScoreBounds bounds = board.scoreBounds();
+            int lower = bounds.marginLower(board.side + 1);
+            int upper = bounds.marginUpper(board.side + 1);
+            if (upper <= alpha || lower == upper) return upper;
+            if (lower >= beta) return lower;
+        }
+
+        int bestScore = INT32_MIN;
+        if constexpr (Plies == 1) {
+            // Last ply: each move fills the board, so its margin is the score
+            for (int slot = NUM_TILES_PER_PLAYER - 1; slot >= 0; slot--) {
+                if (!(held & (1ull << (slot * TILE_COUNT_BITS)))) continue;
+                for (uint32_t left = hexes; left; left &= left - 1) {
+                    int hexId = BitOps::countTrailingZeros(left);
+                    if (hexId == excludedHex && slot == excludedSlot) continue;
+                    nodesSearched++;
+                    bestScore = std::max(bestScore, board.marginAfter(hexId, TILE_VALUES[slot]));
+                    if (bestScore >= beta) return bestScore;
+                }
+            }
+        } else {
+            // Moves best-first by the margin they make now
+            struct EndgameMove { int8_t hexId; int8_t slot; int key; };
+            EndgameMove moves[Plies * NUM_TILES_PER_PLAYER];  // At most Plies empty hexes
+            int count = 0;
+            for (int slot = NUM_TILES_PER_PLAYER - 1; slot >= 0; slot--) {
+                if (!(held & (1ull << (slot * TILE_COUNT_BITS)))) continue;
+                for (uint32_t left = hexes; left; left &= left - 1) {
+                    int hexId = BitOps::countTrailingZeros(left);
+                    if (hexId == excludedHex && slot == excludedSlot) continue;
+                    moves[count++] = {static_cast<int8_t>(hexId), static_cast<int8_t>(slot),
+                                      board.marginAfter(hexId, TILE_VALUES[slot])};
+                }
+            }
+
+            for (int i = 0; i < count; i++) {
+                int best = i;
+                for (int j = i + 1; j < count; j++) {
+                    if (moves[j].key > moves[best].key) best = j;
+                }
+                std::swap(moves[i], moves[best]);
+
+                EndgameBoard child = board;
+                child.play(moves[i].hexId, moves[i].slot);
+                int score = -solveEndgameWith<Plies - 1>(child, -beta, -alpha, nodesSearched, rules);
+                if (score > bestScore) {
+                    bestScore = score;
+                    if (score > alpha) {
+                        alpha = score;
+                        if (alpha >= beta) return bestScore;
+                    }
+                }
+            }
+        }
+        return bestScore == INT32_MIN ? board.margin() : bestScore;  // Every move excluded: game over
+    }
+}
+
+// Solve board (at most ENDGAME_MAX_PLIES empty hexes) within (alpha, beta):
+// same result as an alphaBeta search to the end of the game
+template <typename R>
+int solveEndgame(const HexukiBitboard& board, int alpha, int beta, int64_t& nodesSearched, R rules) {
+    EndgameBoard endgame(board);
+    switch (endgame.emptyHexes()) {
+        case 0: return solveEndgameWith<0>(endgame, alpha, beta, nodesSearched, rules);
+        case 1: return solveEndgameWith<1>(endgame, alpha, beta, nodesSearched, rules);
+        case 2: return solveEndgameWith<2>(endgame, alpha, beta, nodesSearched, rules);
+        case 3: return solveEndgameWith<3>(endgame, alpha, beta, nodesSearched, rules);
+        case 4: return solveEndgameWith<4>(endgame, alpha, beta, nodesSearched, rules);
+        case 5: return solveEndgameWith<5>(endgame, alpha, beta, nodesSearched, rules);
+        case 6: return solveEndgameWith<6>(endgame, alpha, beta, nodesSearched, rules);
+        case 7: return solveEndgameWith<7>(endgame, alpha, beta, nodesSearched, rules);
+        case 8: return solveEndgameWith<8>(endgame, alpha, beta, nodesSearched, rules);
+        default: assert(false && "Too many empty hexes for the endgame kernel"); return 0;
+    }
+}
+
+// Same, reading the rules from the board
+inline int solveEndgame(const HexukiBitboard& board, int alpha, int beta, int64_t& nodesSearched) {
+    return dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        return solveEndgame(board, alpha, beta, nodesSearched, rules);
+    });
+}
+
+static_assert(ENDGAME_MAX_PLIES == 8, "solveEndgame dispatches one case per kernel depth");
+
+} // namespace minimax
+} // namespace hexuki
+
+#endif // HEXUKI_ENDGAME_SOLVER_H
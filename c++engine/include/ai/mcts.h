@@ -3,6 +3,8 @@
 
 #include "core/bitboard.h"
 #include "core/move.h"
+#include "core/move_generator.h"
+#include "core/board_batch.h"
 #include "ai/mcts_node.h"
 #include "ai/minimax.h"
 #include <random>
@@ -25,6 +27,15 @@ struct MCTSConfig {
     bool useMinimaxRollouts = false;  // Use minimax for endgame evaluation
     int minimaxThreshold = 7;         // Switch to minimax at this many empty hexes
 
+    // End a rollout as soon as ScoreBounds prove the winner (same result as
+    // playing it out). Single rollouts only; batched playouts run to the end.
+    bool stopDecidedRollouts = true;
+
+    // Batched rollouts: play this many random games from each new leaf in one
+    // BoardBatch call (counted as that many simulations). Applies to random
+    // rollouts only; minimax rollouts and variant rules use 1.
+    int playoutsPerLeaf = 1;
+
     MCTSConfig() = default;
 };
 
@@ -96,11 +107,14 @@ private:
     // MCTS phases
     MCTSNode* select(MCTSNode* node, HexukiBitboard& board);
     MCTSNode* expand(MCTSNode* node, HexukiBitboard& board);
-    double simulate(HexukiBitboard& board, const MCTSConfig& config);
-    void backpropagate(MCTSNode* node, double score);
+    double simulate(HexukiBitboard& board, const MCTSConfig& config);  // Dispatches on the board's rules
+    template <typename R>
+    double simulateWith(HexukiBitboard& board, const MCTSConfig& config, R rules);
+    double simulateBatch(const HexukiBitboard& board, int playouts);  // Sum of P1 results
+    void backpropagate(MCTSNode* node, double score, int playouts = 1);
 
     // Helper: get all valid moves at current state
-    std::vector<Move> getValidMoves(const HexukiBitboard& board) const;
+    void getValidMoves(const HexukiBitboard& board, MoveList& moves) const;
 
     // Helper: check if game is over
     bool isTerminal(const HexukiBitboard& board) const;
@@ -108,8 +122,8 @@ private:
     // Helper: evaluate terminal position (final score)
     double evaluateTerminal(const HexukiBitboard& board) const;
 
-    // Helper: select random move for simulation
-    Move selectRandomMove(const std::vector<Move>& moves);
+    // Helper: select random move for simulation (sampled without building a move list)
+    Move selectRandomMove(const MoveGenerator& moves);
 
     // Cleanup
     void resetTree();
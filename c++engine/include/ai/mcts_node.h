@@ -33,7 +33,8 @@ public:
     double totalScore;    // Sum of scores from simulations
 
     // Unexpanded moves (moves we haven't created child nodes for yet)
-    std::vector<Move> untriedMoves;
+    // Inline storage: filling a node never touches the heap
+    MoveList untriedMoves;
 
     // Node state
     bool isFullyExpanded() const { return untriedMoves.empty(); }
@@ -56,8 +57,8 @@ public:
         return visits > 0 ? totalScore / visits : 0.0;
     }
 
-    // Update statistics after simulation
-    void update(double score);
+    // Update statistics after simulation (score summed over 'playouts' games)
+    void update(double score, int playouts = 1);
 
     // Delete all children (for memory cleanup)
     void deleteChildren();
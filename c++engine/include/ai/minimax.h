@@ -3,68 +3,41 @@
 
 #include "core/bitboard.h"
 #include "core/move.h"
-#include <unordered_map>
+#include "ai/transposition_table.h"
 #include <chrono>
+#include <string>
+#include <vector>
 
 namespace hexuki {
 namespace minimax {
 
-/**
- * Transposition Table Entry
- * Stores previously evaluated positions to avoid recalculation
- */
-struct TTEntry {
-    enum Flag { EXACT, LOWER_BOUND, UPPER_BOUND };
-
-    int score;          // Evaluation score
-    int depth;          // Depth at which this was evaluated
-    Flag flag;          // Type of bound
-    Move bestMove;      // Best move found at this position
-
-    TTEntry() : score(0), depth(0), flag(EXACT), bestMove() {}
-    TTEntry(int s, int d, Flag f, const Move& m)
-        : score(s), depth(d), flag(f), bestMove(m) {}
-};
-
-/**
- * Transposition Table (hash table for board positions)
- */
-class TranspositionTable {
-public:
-    TranspositionTable(size_t sizeMB = 128);  // Default: 128MB table
-
-    void store(uint64_t hash, const TTEntry& entry);
-    bool probe(uint64_t hash, TTEntry& entry) const;
-    void clear();
-
-    size_t getSize() const { return table.size(); }
-    size_t getHits() const { return hits; }
-    size_t getMisses() const { return misses; }
-
-private:
-    std::unordered_map<uint64_t, TTEntry> table;
-    size_t maxSize;
-    mutable size_t hits;
-    mutable size_t misses;
-};
-
 /**
  * Search statistics and result
  */
 struct SearchResult {
     Move bestMove;          // Best move found
     int score;              // Evaluation score (positive = good for current player)
-    int nodesSearched;      // Total nodes evaluated
+    int64_t nodesSearched;  // Total nodes evaluated (all threads)
+    std::vector<int64_t> threadNodes;  // Nodes per search thread ([0] = main thread)
     double timeMs;          // Time taken in milliseconds
     int depth;              // Final depth reached
+    std::vector<Move> pv;   // Principal variation of the last completed depth (bestMove first)
     bool timeout;           // Did search hit time limit?
 
-    // Transposition table stats
+    // Transposition table stats (probes by all threads)
     size_t ttHits;
     size_t ttMisses;
 
+    // Move ordering stats (main thread): beta cutoffs, and how many came
+    // from the first move searched
+    int cutoffs;
+    int firstMoveCutoffs;
+
     SearchResult() : bestMove(), score(0), nodesSearched(0), timeMs(0.0),
-                     depth(0), timeout(false), ttHits(0), ttMisses(0) {}
+                     depth(0), timeout(false), ttHits(0), ttMisses(0),
+                     cutoffs(0), firstMoveCutoffs(0) {}
+
+    double firstMoveCutoffRate() const { return cutoffs ? double(firstMoveCutoffs) / cutoffs : 0.0; }
 };
 
 /**
@@ -75,8 +48,14 @@ struct SearchConfig {
     int timeLimitMs = 30000;        // Time limit (30 seconds default)
     bool useIterativeDeepening = true;  // Start shallow, go deeper
     bool useMoveOrdering = true;    // Order moves to improve pruning
+    bool useSearchHeuristics = true;  // Killer/history/countermove ordering (false: TT move + static order)
+    bool useEnhancedTranspositionCutoffs = false;  // Probe children in the TT before searching them (fewer nodes, more time per node)
+    bool useScoreBounds = true;     // Cut nodes whose reachable score range (ScoreBounds) already decides the window
+    int endgamePlies = 5;           // Solve the last this many empty hexes with the endgame kernel (0 = off, max ENDGAME_MAX_PLIES)
     bool useTranspositionTable = true;  // Cache positions
     size_t ttSizeMB = 128;          // Transposition table size
+    TranspositionTable* tt = nullptr;  // Table to reuse across searches; null = a fresh ttSizeMB table per search
+    int threads = 1;                // Search threads (Lazy SMP with iterative deepening)
     bool verbose = false;           // Print search info
 
     SearchConfig() = default;
@@ -85,12 +64,19 @@ struct SearchConfig {
 /**
  * Main minimax search function with alpha-beta pruning
  *
+ * With config.threads > 1 (and iterative deepening), runs Lazy SMP: helper
+ * threads search the same root with varied depth and move order, sharing
+ * the transposition table; the main thread's result is returned.
+ *
  * @param board Current game state
  * @param config Search configuration
  * @return Search result with best move and statistics
  */
 SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config = SearchConfig());
 
+// Principal variation as move notation ("h6t5 h7t4 ...")
+std::string formatPv(const std::vector<Move>& pv);
+
 /**
  * Simple interface: just search to a specific depth
  */
@@ -98,6 +84,7 @@ SearchResult findBestMove(HexukiBitboard& board, int depth, int timeLimitMs = 30
 
 /**
  * Alpha-beta search (internal, recursive)
+ * Runs the search specialized for board.getRuleFlags() (see dispatchRules)
  *
  * @param board Current position
  * @param depth Remaining depth to search
@@ -115,11 +102,45 @@ int alphaBeta(
     int alpha,
     int beta,
     TranspositionTable& tt,
-    int& nodesSearched,
+    int64_t& nodesSearched,
     std::chrono::steady_clock::time_point startTime,
     int timeLimitMs
 );
 
+/**
+ * Game outcome for the side to move (the sign of the final margin)
+ * UNKNOWN: the solve ran out of time
+ */
+enum class Outcome { LOSS = -1, DRAW = 0, WIN = 1, UNKNOWN = 2 };
+
+/**
+ * Win/draw/loss solver: searches to the end of the game, but only decides
+ * the sign of the final margin, never its size
+ *
+ * Two null-window searches over outcomes (MTD-style around 0): "better than
+ * a draw?", then if not, "at least a draw?". Every node cuts off as soon as
+ * one move wins (or its ScoreBounds already settle the outcome), which is
+ * much less work than an exact-score alphaBeta.
+ *
+ * Entries go into tt under keys of their own (they never meet score
+ * entries, so one table can serve both searches) and hold an outcome as
+ * the score: a WIN lower bound or LOSS upper bound is stored as exact.
+ *
+ * @param board Position to solve (restored on return)
+ * @param tt Transposition table (may be shared with alphaBeta/findBestMove)
+ * @param nodesSearched Counter for nodes visited
+ * @param timeLimitMs Time limit; UNKNOWN when reached
+ */
+Outcome solveOutcome(
+    HexukiBitboard& board,
+    TranspositionTable& tt,
+    int64_t& nodesSearched,
+    int timeLimitMs = 30000
+);
+
+// Same, with this thread's own table (kept across calls)
+Outcome solveOutcome(HexukiBitboard& board);
+
 /**
  * Quiescence search (search until position is "quiet")
  * Helps avoid horizon effect in tactical positions
@@ -129,14 +150,14 @@ int quiescence(
     int alpha,
     int beta,
     TranspositionTable& tt,
-    int& nodesSearched
+    int64_t& nodesSearched
 );
 
 /**
  * Move ordering: sort moves to search best ones first
  * Better move ordering = more alpha-beta cutoffs = faster search
  */
-void orderMoves(std::vector<Move>& moves, HexukiBitboard& board, const TTEntry* ttEntry = nullptr);
+void orderMoves(MoveList& moves, HexukiBitboard& board, const TTEntry* ttEntry = nullptr);
 
 /**
  * Simple evaluation function
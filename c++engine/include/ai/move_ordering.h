@@ -0,0 +1,159 @@
+#ifndef HEXUKI_MOVE_ORDERING_H
+#define HEXUKI_MOVE_ORDERING_H
+
+#include <cstdlib>
+#include <utility>
+#include "core/move.h"
+#include "core/move_generator.h"
+#include "utils/constants.h"
+
+namespace hexuki {
+namespace minimax {
+
+// Fixed preference used before the search has learned anything: high tiles
+// first, then the hexes around the center (4, 6, 7, 9, 11, 12)
+inline int staticMoveScore(const Move& move) {
+    int score = move.tileValue * 100;
+    if (move.hexId == 9 || move.hexId == 4 || move.hexId == 6 ||
+        move.hexId == 7 || move.hexId == 11 || move.hexId == 12) {
+        score += 500;
+    }
+    return score;
+}
+
+/**
+ * Move ordering learned during one search (one per search thread)
+ *
+ * - Killers: the last two moves that caused a beta cutoff at each ply
+ * - History: butterfly table [side][hex][tile] crediting cutoff moves with
+ *   depth^2 and debiting the moves tried before them; the update is scaled
+ *   toward HISTORY_MAX so entries stay bounded without aging passes
+ * - Countermoves: the move that last refuted each previous move [hex][tile]
+ *
+ * score() ranks TT move > killers > countermove > history + static score.
+ */
+class MoveOrdering {
+public:
+    static constexpr int TT_MOVE_SCORE = 1 << 30;
+    static constexpr int KILLER_SCORE = 1 << 28;  // + 1 for the newer killer
+    static constexpr int COUNTERMOVE_SCORE = 1 << 27;
+    static constexpr int HISTORY_MAX = 1 << 20;
+    static constexpr int MAX_PLY = MAX_PLIES + 2;
+
+    MoveOrdering() : killers(), history(), counterMoves() {}
+
+    int score(const Move& move, int ply, int side, const Move& previous, const Move& ttMove) const {
+        if (move == ttMove) return TT_MOVE_SCORE;
+        if (move == killers[ply][0]) return KILLER_SCORE + 1;
+        if (move == killers[ply][1]) return KILLER_SCORE;
+        if (previous.hexId >= 0 && move == counterMoves[previous.hexId][previous.tileValue]) return COUNTERMOVE_SCORE;
+        return history[side][move.hexId][move.tileValue] + staticMoveScore(move);
+    }
+
+    // Move caused a beta cutoff at ply after the moves in tried[0..triedCount) failed to
+    void recordCutoff(const Move& move, int ply, int side, const Move& previous, int depth,
+                      const Move* tried, int triedCount) {
+        if (killers[ply][0] != move) {
+            killers[ply][1] = killers[ply][0];
+            killers[ply][0] = move;
+        }
+        if (previous.hexId >= 0) counterMoves[previous.hexId][previous.tileValue] = move;
+
+        int bonus = depth * depth;
+        updateHistory(history[side][move.hexId][move.tileValue], bonus);
+        for (int i = 0; i < triedCount; i++) {
+            updateHistory(history[side][tried[i].hexId][tried[i].tileValue], -bonus);
+        }
+    }
+
+    Move getKiller(int ply, int slot) const { return killers[ply][slot]; }
+    int getHistory(int side, const Move& move) const { return history[side][move.hexId][move.tileValue]; }
+    Move getCounterMove(const Move& previous) const { return counterMoves[previous.hexId][previous.tileValue]; }
+
+private:
+    static void updateHistory(int& entry, int bonus) {
+        entry += bonus - entry * std::abs(bonus) / HISTORY_MAX;
+    }
+
+    Move killers[MAX_PLY][2];
+    int history[2][NUM_HEXES][MAX_TILE_VALUE + 1];  // [side][hex][tile]
+    Move counterMoves[NUM_HEXES][MAX_TILE_VALUE + 1];
+};
+
+/**
+ * Yields a node's moves best-first in stages, so a cutoff on an early move
+ * skips the work for the rest:
+ * 1. Staged moves (TT move, then killers), each checked for legality
+ *    against the generator; nothing is generated yet
+ * 2. Every other move is generated and scored
+ * 3. Each next() selects the best remaining one (selection sort on demand)
+ *
+ * Moves are yielded from one array in order, so the ones picked so far are
+ * always its prefix (pickedMoves()).
+ */
+constexpr int MAX_STAGED_MOVES = 3;  // TT move + two killers
+
+template <typename ScoreFn>
+class MovePicker {
+public:
+    MovePicker(MoveGenerator& moveGenerator, const Move* candidates, int candidateCount, ScoreFn scoreFn)
+        : generator(moveGenerator), score(scoreFn), stagedCount(0), count(0), index(0), generated(false) {
+        for (int i = 0; i < candidateCount && i < MAX_STAGED_MOVES; i++) {
+            if (!generator.contains(candidates[i]) || isStaged(candidates[i])) continue;
+            moves[stagedCount++] = candidates[i];
+        }
+        count = stagedCount;
+    }
+
+    bool next(Move& move) {
+        if (index == count && !generated) generateRest();
+        if (index == count) return false;
+        if (index >= stagedCount) {
+            int best = index;
+            for (int i = index + 1; i < count; i++) {
+                if (scores[i] > scores[best]) best = i;
+            }
+            std::swap(moves[index], moves[best]);
+            std::swap(scores[index], scores[best]);
+        }
+        move = moves[index++];
+        return true;
+    }
+
+    int picked() const { return index; }
+    const Move* pickedMoves() const { return moves; }  // The picked() moves so far, in order
+    bool generatedRest() const { return generated; }
+
+private:
+    bool isStaged(const Move& move) const {
+        for (int i = 0; i < stagedCount; i++) {
+            if (moves[i] == move) return true;
+        }
+        return false;
+    }
+
+    void generateRest() {
+        generated = true;
+        Move move;
+        while (generator.next(move)) {
+            if (isStaged(move)) continue;
+            moves[count] = move;
+            scores[count] = score(move);
+            count++;
+        }
+    }
+
+    MoveGenerator& generator;
+    ScoreFn score;
+    int stagedCount;
+    Move moves[MoveList::CAPACITY];
+    int scores[MoveList::CAPACITY];
+    int count;
+    int index;
+    bool generated;
+};
+
+} // namespace minimax
+} // namespace hexuki
+
+#endif // HEXUKI_MOVE_ORDERING_H
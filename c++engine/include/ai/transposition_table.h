@@ -0,0 +1,100 @@
+#ifndef HEXUKI_TRANSPOSITION_TABLE_H
+#define HEXUKI_TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "core/move.h"
+
+namespace hexuki {
+namespace minimax {
+
+/**
+ * Transposition Table Entry
+ * Stores previously evaluated positions to avoid recalculation
+ * (the unpacked form returned by probe() and passed to store())
+ */
+struct TTEntry {
+    enum Flag { EXACT, LOWER_BOUND, UPPER_BOUND };
+
+    int score;          // Evaluation score
+    int depth;          // Depth at which this was evaluated
+    Flag flag;          // Type of bound
+    Move bestMove;      // Best move found at this position
+
+    TTEntry() : score(0), depth(0), flag(EXACT), bestMove() {}
+    TTEntry(int s, int d, Flag f, const Move& m)
+        : score(s), depth(d), flag(f), bestMove(m) {}
+};
+
+/**
+ * Transposition Table (hash table for board positions)
+ *
+ * A power-of-two array of 64-byte (one cache line) buckets of 4 entries,
+ * so a probe touches one line. The low bits of the key pick the bucket.
+ *
+ * Each entry is two 64-bit words: packed data (score, depth, flag, 1-byte
+ * move, generation) and key ^ data. A probe only accepts an entry whose
+ * words XOR back to the full key, so threads can store and probe without
+ * locks: an entry torn by a concurrent write simply misses.
+ *
+ * Replacement: an entry for the same key is overwritten unless it is deeper
+ * and from the current search; otherwise the bucket's least valuable entry
+ * (shallowest, oldest generation first) goes. newSearch() ages the table
+ * instead of clearing it, so one table serves a whole game.
+ *
+ * probe() writes nothing shared: callers count their own hits and misses
+ * (see SearchResult::ttHits), so threads never contend on a counter.
+ */
+class TranspositionTable {
+public:
+    static constexpr int BUCKET_ENTRIES = 4;
+
+    TranspositionTable(size_t sizeMB = 128);  // Default: 128MB table
+
+    void store(uint64_t hash, const TTEntry& entry);
+    bool probe(uint64_t hash, TTEntry& entry) const;
+    void clear();
+
+    // Start a new search: entries from earlier searches become replaceable first
+    void newSearch();
+
+    // Reallocate for a new size (clears); no-op if the size is unchanged
+    void resize(size_t sizeMB);
+
+    // Hint the CPU to load the bucket for hash (call well before probe)
+    void prefetch(uint64_t hash) const {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&buckets[hash & bucketMask]);
+#else
+        (void)hash;
+#endif
+    }
+
+    size_t getSizeMB() const { return sizeMB; }
+    size_t getCapacity() const { return (bucketMask + 1) * BUCKET_ENTRIES; }  // Entries
+    int getUsagePermille() const;  // Entries from this search, sampled (UCI "hashfull")
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> keyXorData;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[BUCKET_ENTRIES];
+    };
+
+    static_assert(sizeof(Bucket) == 64, "A bucket must be one cache line");
+
+    std::unique_ptr<Bucket[]> buckets;
+    uint64_t bucketMask;
+    size_t sizeMB;
+    uint8_t generation;  // Low GENERATION_BITS used
+};
+
+} // namespace minimax
+} // namespace hexuki
+
+#endif // HEXUKI_TRANSPOSITION_TABLE_H
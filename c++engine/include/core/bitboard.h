@@ -4,8 +4,17 @@
 #include <cstdint>
 #include <vector>
 #include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include "core/move.h"
+#include "core/legal_mask_table.h"
+#include "core/packed_position.h"
+#include "core/rules.h"
+#include "core/score_bounds.h"
+#include "core/zobrist.h"
 #include "utils/constants.h"
+#include "utils/timer.h"
 
 namespace hexuki {
 
@@ -17,6 +26,18 @@ namespace hexuki {
  * - Each player has tiles [1,2,3,4,5,6,7,8,9], use ONCE
  * - Scoring: Multiply tile values along 5 diagonal chains per player
  * - Move rules: adjacent, chain length constraint, anti-symmetry
+ *
+ * The board is trivially copyable and fits in four cache lines, so copying
+ * it (copy-make, storing boards in search stacks) costs a few stores.
+ *
+ * Every makeMove is recorded on a fixed-depth undo stack (one entry per
+ * hex), so unmakeMove() restores the whole state without the caller
+ * remembering the move. The same stack is the game's move history:
+ * getMove(ply), multi-level undo and toNotation()/fromNotation().
+ *
+ * Variant rules (center start, free opening, anti-symmetry, chain length
+ * rule) are runtime flags here; see core/rules.h for the compile-time
+ * policy used by search kernels and core/rule_variants.h for named setups.
  */
 class HexukiBitboard {
 public:
@@ -33,26 +54,94 @@ public:
 
     // Tile availability
     bool isTileAvailable(int player, int tileValue) const;
-    std::vector<int> getAvailableTiles(int player) const;
+    int getTileCount(int player, int tileValue) const;  // Copies of a value left (duplicates allowed)
+    std::vector<int> getAvailableTiles(int player) const;  // Sorted by TILE_VALUES order
+    uint64_t getTileInventory(int player) const {         // Packed counts (see TILE_COUNT_BITS)
+        return (player == PLAYER_1) ? p1Tiles : p2Tiles;
+    }
 
     // Scoring (REAL chain-based multiplication)
-    int getScore(int player) const;
+    // Chain products and totals are maintained in makeMove/unmakeMove, so this is a load
+    int getScore(int player) const { return playerScores[player - 1]; }
+    int getChainProduct(int player, int chain) const { return chainProducts[player - 1][chain]; }
+
+    // Range each final score can still reach from here (see core/score_bounds.h)
+    ScoreBounds getScoreBounds() const {
+        return ScoreBounds::compute(chainProducts, playerScores, hexOccupied, p1Tiles, p2Tiles);
+    }
+
+    uint32_t getOccupiedMask() const { return hexOccupied; }  // Bit i = hex i has a tile
+
+    // Legal empty hexes (adjacency + chain length rules) as a 19-bit mask
+    uint32_t getLegalHexMask() const { return legalHexMask(hexOccupied, ruleFlags); }
+    uint32_t computeLegalHexMask() const;  // Same result by walking the rules (no table)
 
     // Move operations
+    void generateMoves(MoveList& moves) const;  // Allocation-free (search hot paths)
     std::vector<Move> getValidMoves() const;
     bool isValidMove(const Move& move) const;
     void makeMove(const Move& move);
-    void unmakeMove(const Move& move);  // Undo move (for minimax)
+    void unmakeMove();                  // Undo the last move from the undo stack
+    void unmakeMove(const Move& move);  // Same, checking (debug) that move was the last one made
+
+    // Undo stack / move history
+    int getPly() const { return undoCount; }  // Moves made since the last setup/reset
+    Move getLastMove() const { return undoCount ? undoStack[undoCount - 1].move : Move(); }
+    Move getMove(int ply) const { return (ply >= 0 && ply < undoCount) ? undoStack[ply].move : Move(); }
+    void unmakeMoves(int count);  // Undo the last count moves (clamped to getPly())
+    void undoToPly(int ply) { unmakeMoves(undoCount - ply); }
+
+    // Rule flags (RuleFlag bits, DEFAULT_RULE_FLAGS by default). They survive
+    // reset/loadPosition and are part of the hash; call reset() after changing
+    // RULE_CENTER_START to get the new starting position.
+    void setRuleFlags(uint8_t flags);
+    uint8_t getRuleFlags() const { return ruleFlags; }
+
+    // Anti-symmetry rule (JS engine): from the second move on, a move may not
+    // leave the board mirrored across the center column. Off by default.
+    void setAntiSymmetry(bool enabled) {
+        setRuleFlags(enabled ? (ruleFlags | RULE_ANTI_SYMMETRY) : (ruleFlags & ~RULE_ANTI_SYMMETRY));
+    }
+    bool isAntiSymmetryEnabled() const { return (ruleFlags & RULE_ANTI_SYMMETRY) != 0; }
+    bool isAntiSymmetryActive() const {  // Enabled, identical tile sets, and past the first move
+        return isAntiSymmetryEnabled() && tilesAreIdentical && BitOps::popcount(hexOccupied) >= 2;
+    }
+    bool isBoardMirrored() const { return mirrorMismatch == 0; }
+    uint32_t getMirrorMismatch() const { return mirrorMismatch; }
+    bool createsMirroredBoard(const Move& move) const;  // Would this (legal) move be rejected?
 
     // Utility
     void reset();  // Reset to initial game state
-    uint64_t getHash() const { return zobristHash; }  // For transposition table
+
+    // Zobrist hash (for transposition table): tiles, side to move, both hands
+    // and rule flags, kept incrementally and always equal to Zobrist::hash(*this)
+    uint64_t getHash() const { return zobristHashes[0]; }
+
+    // Symmetry-aware keys (see SYMMETRY_HEX_MAP): getSymmetricHash(s) is the hash of
+    // the position transformed by s. The canonical key is the smallest of them, so
+    // every symmetric position shares it; store moves as move.transformed(s) with
+    // s = getCanonicalSymmetry() and map them back the same way (s is an involution).
+    uint64_t getSymmetricHash(int symmetry) const { return zobristHashes[symmetry]; }
+    uint64_t getCanonicalHash() const { return zobristHashes[getCanonicalSymmetry()]; }
+    int getCanonicalSymmetry() const {
+        int best = 0;
+        for (int s = 1; s < NUM_SYMMETRIES; s++) {
+            if (zobristHashes[s] < zobristHashes[best]) best = s;
+        }
+        return best;
+    }
+
+    // Upper half of a 128-bit key (Zobrist::hashHigh), recomputed on each call:
+    // only perft's unique-position counts need it, so the board doesn't carry it
+    uint64_t getHashHigh(int symmetry = 0) const;
+    HashKey128 getHash128(int symmetry = 0) const { return HashKey128{zobristHashes[symmetry], getHashHigh(symmetry)}; }
 
     // Puzzle setup (for loading partial positions)
     void setHexValue(int hexId, int tileValue);  // Place a tile on a hex
     void removeHexValue(int hexId);              // Remove a tile from a hex
     void setAvailableTiles(int player, const std::vector<int>& tiles);  // Set player's available tiles
-    void setCurrentPlayer(int player) { currentPlayer = player; }
+    void setTileInventory(int player, uint64_t inventory);  // Same, from packed counts
+    void setCurrentPlayer(int player);
     void clearBoard();  // Clear all tiles (but keep metadata)
 
     // Load position from string notation
@@ -60,12 +149,26 @@ public:
     //   h0:1 = hex 0 has tile value 1
     //   p1:2,3,4 = player 1 has tiles 2,3,4 available
     //   turn:1 = player 1 to move
-    void loadPosition(const std::string& position);
+    // Returns false and leaves the board unchanged on malformed input
+    // (parsePosition in core/notation.h reports where)
+    bool loadPosition(std::string_view position);
     std::string savePosition() const;  // Save current position to string
 
+    // Binary form (16 bytes, see PackedPosition): tiles, hands, side to move and
+    // rule flags. unpack() is a setup call like loadPosition (clears the undo stack).
+    PackedPosition pack() const;
+    void unpack(const PackedPosition& position);
+
     // Debug
     void print() const;  // Print board state (for debugging)
-    std::string toNotation() const;  // Convert to move sequence string
+
+    // Game record: the moves since the last setup, e.g. "h6t5 h7t4 h2t1".
+    // Games that didn't start from reset() are prefixed with the starting
+    // position in loadPosition format: "h9:1,h4:3|p1:..|p2:..|turn:2 h6t5".
+    // fromNotation replays a record under the board's rules (every move is
+    // validated; returns false and leaves the board unchanged on error).
+    std::string toNotation() const;
+    bool fromNotation(std::string_view notation);
 
 private:
     // ========================================================================
@@ -79,57 +182,64 @@ private:
     // Using 4 bits per hex (0-15 range, we use 0-9)
     uint8_t hexValues[NUM_HEXES];
 
-    // Available tiles for each player (array-based to support duplicates)
-    // Can now handle asymmetric tiles like [1,1,1,1,1,1,1,1,1] vs [2,2,2,2,2,2,2,2,2]
-    std::vector<int> p1AvailableTiles;  // e.g. [1,2,3,4,5,6,7,8,9] or [1,1,1,1,1,1,1,1,1]
-    std::vector<int> p2AvailableTiles;
+    // Available tiles for each player: 4-bit count per TILE_VALUES slot
+    // Supports duplicates/asymmetric sets like [1,1,1,1,1,1,1,1,1] vs [2,2,2,2,2,2,2,2,2]
+    uint64_t p1Tiles;
+    uint64_t p2Tiles;
 
     // Metadata
     int currentPlayer;  // PLAYER_1 or PLAYER_2
 
-    // Anti-symmetry tracking (optimization)
-    bool symmetryStillPossible;
+    // Anti-symmetry tracking: off-center hexes whose value differs from their
+    // mirror's (empty counts as 0). Zero means the board is mirrored.
+    uint32_t mirrorMismatch;
+    uint8_t ruleFlags;       // RuleFlag bits (survive reset/loadPosition)
     bool tilesAreIdentical;  // Only enforce anti-symmetry if both players have identical starting tiles
 
-    // Zobrist hashing (for transposition table)
-    uint64_t zobristHash;
+    // Zobrist hashing (for transposition table): [0] = this position,
+    // [s] = the position under symmetry s, all updated incrementally
+    uint64_t zobristHashes[NUM_SYMMETRIES];
+
+    // Incremental scoring: product of placed tiles on each chain (empty = 1)
+    // and each player's total. Define HEXUKI_VERIFY_SCORE to check every
+    // update against a full recompute.
+    int32_t chainProducts[2][CHAINS_PER_PLAYER];  // [player - 1][chain]
+    int32_t playerScores[2];                      // [player - 1]
+
+    // Undo stack: everything else is restored by inverting the move
+    struct UndoEntry {
+        Move move;
+        bool tookTile;  // False if the tile wasn't in the inventory (puzzle setups)
+    };
+    UndoEntry undoStack[MAX_PLIES];
+    uint8_t undoCount;
 
     // ========================================================================
     // Internal helpers
     // ========================================================================
 
-    // Adjacency
-    std::vector<int> getAdjacentHexes(int hexId) const;
-    bool hasAdjacentOccupied(int hexId) const;
-
-    // Move legality (REAL rules)
-    bool isMoveLegal(int hexId) const;  // Check position legality
-    bool checkChainLengthConstraint(int hexId) const;  // Chain length rule
-    bool isBoardMirrored() const;  // Anti-symmetry check
-
-    // Chain info structure (for affected chain tracking)
-    struct ChainInfo {
-        int length;
-        std::vector<int> hexIds;
-    };
-
-    // Chain detection (for chain length constraint)
-    std::vector<int> getChainLengthsFromStart(int startHex, const Direction& dir) const;
-    std::vector<int> getAllChainLengths() const;
-    void getFirstAndSecondChainLengths(int& first, int& second) const;
-    std::vector<ChainInfo> getAllChainsWithMembers() const;  // Get chains with hex IDs
+    // Anti-symmetry bookkeeping
+    void updateMirrorMismatch(int hexId);  // Refresh the pair containing hexId
+    void rebuildMirrorMismatch();
 
     // Scoring helpers
-    int calculatePlayerScore(int player) const;
+    int calculatePlayerScore(int player) const;  // Full recompute (reference)
     int calculateChainScore(const int* chain, int chainLength) const;
-
-    // Zobrist hashing
-    void updateZobristHash(const Move& move);
-
-    // Helper: find hex at row/col
-    int findHexAt(int row, int col) const;
+    void addToScores(int hexId, int tileValue);
+    void removeFromScores(int hexId, int tileValue);
+    void rebuildScores();  // Recompute products and totals (puzzle setup)
+    void verifyIncrementalState() const;  // HEXUKI_VERIFY_SCORE self-check
+
+    // Zobrist hashing: count = the mover's count of the tile value before
+    // makeMove took one (0 if it took none)
+    void updateZobristHash(const Move& move, int mover, int count);
+    void rebuildHashes();  // Full recompute of every symmetric hash
+    void verifyHashes() const;  // HEXUKI_VERIFY_HASH self-check
 };
 
+static_assert(std::is_trivially_copyable<HexukiBitboard>::value, "Board copies must be plain memcpy");
+static_assert(sizeof(HexukiBitboard) <= 256, "Board must fit in four cache lines");
+
 } // namespace hexuki
 
 #endif // HEXUKI_BITBOARD_H
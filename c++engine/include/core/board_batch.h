@@ -0,0 +1,84 @@
+#ifndef HEXUKI_BOARD_BATCH_H
+#define HEXUKI_BOARD_BATCH_H
+
+#include <cstdint>
+#include "core/bitboard.h"
+#include "utils/constants.h"
+
+namespace hexuki {
+
+/**
+ * Struct-of-arrays batch of boards for lockstep random playouts
+ *
+ * Holds Width boards (8, 16 or 32) with each field stored lane-contiguous,
+ * so one AVX2 register covers 8 boards. step() advances every lane by one
+ * random ply:
+ * - Legal hexes: gather from LegalMaskTable by occupancy
+ * - Random move: one random legal hex x one random held tile value
+ *   (independent uniform draws = uniform over the cross product)
+ * - Placement: occupancy, hex values and tile counts updated branch-free
+ * Scoring multiplies the chains of every lane at once.
+ *
+ * All lanes move together, so they share the side to move. A lane whose
+ * side to move has no legal move is finished (as in MCTS::simulate) and
+ * stops changing. Lanes use their own xorshift32 streams; the AVX2 and
+ * scalar kernels draw the same numbers, so a batch plays the same games
+ * either way.
+ *
+ * Random rollouts under DEFAULT_RULE_FLAGS only (callers fall back to
+ * HexukiBitboard for other rules, e.g. anti-symmetry).
+ */
+template <int Width>
+class BoardBatch {
+public:
+    static_assert(Width >= 8 && Width % 8 == 0, "BoardBatch width must be a multiple of 8");
+    static constexpr int WIDTH = Width;
+
+    BoardBatch();
+
+    // Copy one position into every lane; seed picks the lanes' random streams
+    void load(const HexukiBitboard& board, uint32_t seed);
+
+    // One ply in every lane; returns false once no lane could move
+    bool step();        // AVX2 when compiled in, scalar otherwise
+    bool stepScalar();  // Reference kernel (same results as step)
+
+    // Play every lane to the end; returns the number of plies played
+    int playout();
+    int playoutScalar();
+
+    // Chain scores of every lane
+    void computeScores(int32_t p1Scores[Width], int32_t p2Scores[Width]) const;
+
+    // Result per lane from P1's perspective (1.0 win, 0.0 loss, 0.5 draw) and
+    // the sum over the first 'lanes' lanes (all by default)
+    double evaluateTerminal(double results[Width] = nullptr, int lanes = Width) const;
+
+    int getCurrentPlayer() const { return currentPlayer; }
+    uint32_t getOccupiedMask(int lane) const { return occupied[lane]; }
+    int getTileValue(int lane, int hexId) const { return static_cast<int>(values[hexId][lane]); }
+    int getTileCount(int lane, int player, int tileValue) const {
+        int slot = TILE_SLOTS[tileValue];
+        return slot < 0 ? 0 : static_cast<int>(counts[player - 1][slot][lane]);
+    }
+
+    static bool hasSimdKernel();  // True when step() uses AVX2
+
+private:
+    alignas(32) uint32_t occupied[Width];
+    alignas(32) uint32_t values[NUM_HEXES][Width];                  // Tile value per hex (0 = empty)
+    alignas(32) uint32_t counts[2][NUM_TILES_PER_PLAYER][Width];    // [player - 1][TILE_VALUES slot]
+    alignas(32) uint32_t rngState[Width];
+    alignas(32) uint32_t live[Width];  // All ones until the lane's game ends
+    int currentPlayer;
+
+    bool stepSimd();
+};
+
+extern template class BoardBatch<8>;
+extern template class BoardBatch<16>;
+extern template class BoardBatch<32>;
+
+} // namespace hexuki
+
+#endif // HEXUKI_BOARD_BATCH_H
@@ -0,0 +1,132 @@
+#ifndef HEXUKI_HEX_BOARD_H
+#define HEXUKI_HEX_BOARD_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "core/move.h"
+#include "core/rules.h"
+#include "utils/constants.h"
+#include "utils/hex_geometry.h"
+
+namespace hexuki {
+
+/**
+ * Hexuki board of any radius (37- and 61-hex variants)
+ *
+ * Same rules as HexukiBitboard on the board HexGeometry<Radius>
+ * generates: adjacency, chain length rule, anti-symmetry, center start and
+ * free opening (RuleFlag bits), chain-product scoring and Zobrist hashing.
+ * HexukiBitboard stays the engine's fast path for the 19-hex board (32-bit
+ * masks and LegalMaskTable lookups); HexBoard<2> plays the same games and
+ * the tests hold the two to identical legal moves, scores and hashes.
+ *
+ * Differences that come with the size:
+ * - Occupancy and legality are HexGeometry::Mask (uint64_t above 32 hexes)
+ * - Legal hexes are computed per position (2^61 occupancies can't be tabled)
+ *   from per-line occupancy patterns and a histogram of run lengths
+ * - Chain products and scores are 64-bit (nine 9s on a 61-hex chain)
+ * - Each player is dealt TILES_PER_VALUE copies of every TILE_VALUES tile,
+ *   enough to fill their half of the board
+ * - The hash (ZOBRIST_KEYS<NUM_HEXES>) covers the remaining tile counts
+ *   incrementally, so getHash() always equals computeHash()
+ *
+ * Moves reuse Move; hex IDs go up to NUM_HEXES - 1 (Move::isValid only
+ * knows the 19-hex board, so use isValidMove here).
+ */
+template <int Radius>
+class HexBoard {
+public:
+    using Geometry = HexGeometry<Radius>;
+    using Mask = typename Geometry::Mask;
+
+    static constexpr int NUM_HEXES = Geometry::NUM_HEXES;
+    static constexpr int CENTER_HEX = Geometry::CENTER_HEX;
+    static constexpr int MAX_PLIES = NUM_HEXES;
+    static constexpr int MAX_MOVES = NUM_HEXES * NUM_TILES_PER_PLAYER;  // Every hex x every tile value
+    static constexpr int TILES_PER_VALUE =
+        ((NUM_HEXES - 1) / 2 + NUM_TILES_PER_PLAYER - 1) / NUM_TILES_PER_PLAYER;
+
+    static_assert(TILES_PER_VALUE <= MAX_TILE_COUNT, "Dealt tiles must fit the packed inventory");
+    static_assert(NUM_HEXES <= 127, "Hex IDs must fit Move::hexId");
+
+    explicit HexBoard(uint8_t ruleFlags = DEFAULT_RULE_FLAGS);
+
+    void reset();  // Starting position under the board's rule flags
+    uint8_t getRuleFlags() const { return ruleFlags; }
+
+    // Game state queries
+    bool isHexOccupied(int hexId) const { return (hexOccupied >> hexId) & 1; }
+    int getTileValue(int hexId) const { return hexValues[hexId]; }
+    int getCurrentPlayer() const { return currentPlayer; }
+    Mask getOccupiedMask() const { return hexOccupied; }
+    bool isGameOver() const { return hexOccupied == Geometry::ALL_HEXES_MASK; }
+    int getPly() const { return undoCount; }
+
+    int getTileCount(int player, int tileValue) const;
+    uint64_t getTileInventory(int player) const { return tiles[player - 1]; }
+
+    // Scoring (maintained incrementally, like HexukiBitboard)
+    int64_t getScore(int player) const { return playerScores[player - 1]; }
+    int64_t getChainProduct(int player, int chain) const { return chainProducts[player - 1][chain]; }
+
+    // Move operations
+    Mask getLegalHexMask() const;                // Legal empty hexes (adjacency + chain length rules)
+    bool allowsPlacement(int hexId) const;       // Chain length rule alone for empty hexId
+    bool createsMirroredBoard(const Move& move) const;
+    bool isValidMove(const Move& move) const;
+    int generateMoves(Move* moves) const;        // moves must hold MAX_MOVES; returns the count
+    std::vector<Move> getValidMoves() const;
+    void makeMove(const Move& move);
+    void unmakeMove();
+
+    // Uniform random legal moves until the side to move is stuck or the board
+    // is full (as MCTS::simulate); returns the plies played
+    int playout(std::mt19937& rng);
+
+    // Zobrist hash (incremental) and the same value recomputed from scratch
+    uint64_t getHash() const { return zobristHash; }
+    uint64_t computeHash() const;
+
+private:
+    static constexpr int MAX_LINE_LENGTH = Geometry::MAX_CHAIN_LENGTH;
+
+    Mask hexOccupied;
+    uint8_t hexValues[NUM_HEXES];  // 0 = empty
+    uint64_t tiles[2];             // Packed counts per TILE_VALUES slot (see TILE_COUNT_BITS)
+    int currentPlayer;
+    uint8_t ruleFlags;
+
+    // Anti-symmetry: hexes whose value differs from their mirror's (0 = mirrored)
+    Mask mirrorMismatch;
+
+    // Chain length rule: occupancy pattern of every line (bit i = i-th hex
+    // along it) and the number of runs of each length on the board
+    uint16_t linePatterns[Geometry::NUM_LINES];
+    uint8_t runCounts[MAX_LINE_LENGTH + 1];
+
+    int64_t chainProducts[2][Geometry::CHAINS_PER_PLAYER];  // [player - 1][chain]
+    int64_t playerScores[2];
+
+    uint64_t zobristHash;
+
+    struct UndoEntry {
+        Move move;
+        bool tookTile;
+    };
+    UndoEntry undoStack[MAX_PLIES];
+    uint8_t undoCount;
+
+    void place(int hexId, int tileValue);   // Tile, scores, lines, mirror (no hash/inventory)
+    void remove(int hexId, int tileValue);
+    void updateMirrorMismatch(int hexId);
+    bool isAntiSymmetryActive() const;
+};
+
+extern template class HexBoard<2>;
+extern template class HexBoard<3>;
+extern template class HexBoard<4>;
+
+} // namespace hexuki
+
+#endif // HEXUKI_HEX_BOARD_H
@@ -0,0 +1,54 @@
+#ifndef HEXUKI_LEGAL_MASK_TABLE_H
+#define HEXUKI_LEGAL_MASK_TABLE_H
+
+#include <cstdint>
+#include "utils/constants.h"
+
+namespace hexuki {
+
+/**
+ * Occupancy-indexed table of legal hexes
+ *
+ * Whether an empty hex may be played (adjacency + chain length rules)
+ * depends only on the 19-bit occupancy mask, so all 2^19 answers are
+ * precomputed once (2 MB):
+ * - table[hexOccupied] = 19-bit mask of legal empty hexes
+ * - Move generation becomes one load plus a cross product with the tiles
+ *
+ * Variants without the chain length rule use a second table (adjacency
+ * only), built on first use by initializeAdjacent().
+ */
+class LegalMaskTable {
+public:
+    static constexpr uint32_t NUM_OCCUPANCIES = 1u << NUM_HEXES;
+
+    // Build the table once (HexukiBitboard's constructor calls this); safe to
+    // call from several threads at once
+    static void initialize();
+
+    // Legal empty hexes for an occupancy (table must be initialized)
+    static uint32_t lookup(uint32_t hexOccupied) {
+        return table[hexOccupied];
+    }
+
+    // Adjacency-only table (no chain length rule), built on first call like initialize()
+    static void initializeAdjacent();
+    static uint32_t lookupAdjacent(uint32_t hexOccupied) {
+        return adjacentTable[hexOccupied];
+    }
+
+    // Raw table (indexed by occupancy) for vectorized gathers
+    static const uint32_t* data() { return table; }
+
+    // Rule-walking computation (used to build the table, and as a reference)
+    static uint32_t computeLegalHexMask(uint32_t hexOccupied);
+    static uint32_t computeAdjacentHexMask(uint32_t hexOccupied);  // Empty hexes next to a tile
+
+private:
+    static uint32_t table[NUM_OCCUPANCIES];
+    static uint32_t adjacentTable[NUM_OCCUPANCIES];
+};
+
+} // namespace hexuki
+
+#endif // HEXUKI_LEGAL_MASK_TABLE_H
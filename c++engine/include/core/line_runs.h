@@ -0,0 +1,78 @@
+#ifndef HEXUKI_LINE_RUNS_H
+#define HEXUKI_LINE_RUNS_H
+
+#include <cstdint>
+#include <algorithm>
+#include "utils/constants.h"
+#include "utils/timer.h"
+
+namespace hexuki {
+
+/**
+ * Run-length structure of the 15 lines (for the chain length constraint)
+ *
+ * - occupancy[axis] packs the 5-bit pattern of each line on that axis
+ * - histogram packs the number of runs of each length 1-5 on the board
+ *
+ * Adding or removing a hex only touches the 3 lines through it, so the
+ * "longest affected vs. second longest" rule is a constant-time query.
+ */
+struct LineRuns {
+    uint32_t occupancy[LINES_PER_HEX];
+    uint32_t histogram;
+
+    // Build from a 19-bit occupancy mask
+    static LineRuns fromOccupancy(uint32_t hexOccupied) {
+        LineRuns runs = {{0, 0, 0}, 0};
+        for (uint32_t occ = hexOccupied; occ; occ &= occ - 1) {
+            runs.add(BitOps::countTrailingZeros(occ));
+        }
+        return runs;
+    }
+
+    void add(int hexId) {
+        for (int axis = 0; axis < LINES_PER_HEX; axis++) {
+            int shift = LINE_SLOT[HEX_LINES[hexId][axis]] * LINE_PATTERN_BITS;
+            uint32_t oldPattern = (occupancy[axis] >> shift) & LINE_PATTERN_MASK;
+            uint32_t newPattern = oldPattern | (1u << HEX_LINE_POSITIONS[hexId][axis]);
+
+            occupancy[axis] |= newPattern << shift;
+            histogram += LINE_RUN_HISTOGRAM[newPattern] - LINE_RUN_HISTOGRAM[oldPattern];
+        }
+    }
+
+    void remove(int hexId) {
+        for (int axis = 0; axis < LINES_PER_HEX; axis++) {
+            int shift = LINE_SLOT[HEX_LINES[hexId][axis]] * LINE_PATTERN_BITS;
+            uint32_t oldPattern = (occupancy[axis] >> shift) & LINE_PATTERN_MASK;
+            uint32_t newPattern = oldPattern & ~(1u << HEX_LINE_POSITIONS[hexId][axis]);
+
+            occupancy[axis] &= ~(1u << (shift + HEX_LINE_POSITIONS[hexId][axis]));
+            histogram += LINE_RUN_HISTOGRAM[newPattern] - LINE_RUN_HISTOGRAM[oldPattern];
+        }
+    }
+
+    // Chain length rule for placing on empty hexId: the longest chain through
+    // the new tile may be at most 1 longer than the second longest on the board
+    bool allowsPlacement(int hexId) const {
+        // Runs through hexId exist only on its 3 lines, so those give the longest affected chain
+        uint32_t newHistogram = histogram;
+        int longestAffected = 0;
+
+        for (int axis = 0; axis < LINES_PER_HEX; axis++) {
+            int shift = LINE_SLOT[HEX_LINES[hexId][axis]] * LINE_PATTERN_BITS;
+            int pos = HEX_LINE_POSITIONS[hexId][axis];
+            uint32_t oldPattern = (occupancy[axis] >> shift) & LINE_PATTERN_MASK;
+            uint32_t newPattern = oldPattern | (1u << pos);
+
+            newHistogram += LINE_RUN_HISTOGRAM[newPattern] - LINE_RUN_HISTOGRAM[oldPattern];
+            longestAffected = std::max(longestAffected, static_cast<int>(LINE_RUN_THROUGH[newPattern][pos]));
+        }
+
+        return longestAffected <= secondLongestRun(newHistogram) + 1;
+    }
+};
+
+} // namespace hexuki
+
+#endif // HEXUKI_LINE_RUNS_H
@@ -10,16 +10,19 @@ namespace hexuki {
 /**
  * Represents a single move in Hexuki
  * A move consists of placing a tile with a specific value on a hex
+ *
+ * Packed to 2 bytes so move lists, TT entries and tree nodes stay small.
+ * Note: when streaming, cast to int (int8_t/uint8_t print as characters).
  */
 struct Move {
-    int hexId;       // Hex position (0-18)
-    int tileValue;   // Tile value (1-9)
+    int8_t hexId;       // Hex position (0-18), -1 = no move
+    uint8_t tileValue;  // Tile value (1-9)
 
     // Default constructor
     Move() : hexId(-1), tileValue(0) {}
 
     // Constructor
-    Move(int hex, int tile) : hexId(hex), tileValue(tile) {}
+    Move(int hex, int tile) : hexId(static_cast<int8_t>(hex)), tileValue(static_cast<uint8_t>(tile)) {}
 
     // Check if move is valid (not default-constructed)
     bool isValid() const {
@@ -32,12 +35,18 @@ struct Move {
         return false;
     }
 
+    // Same move on the board transformed by a symmetry (see SYMMETRY_HEX_MAP)
+    Move transformed(int symmetry) const {
+        return hexId < 0 ? *this : Move(SYMMETRY_HEX_MAP[symmetry][hexId], tileValue);
+    }
+
     // Convert to string notation (e.g., "h6t5")
     std::string toString() const {
         return "h" + std::to_string(hexId) + "t" + std::to_string(tileValue);
     }
 
-    // Parse from string notation (e.g., "h6t5")
+    // Parse from string notation (e.g., "h6t5"); throws std::invalid_argument
+    // (parseMove in core/notation.h reports errors without exceptions)
     static Move fromString(const std::string& str);
 
     // Equality comparison
@@ -50,6 +59,42 @@ struct Move {
     }
 };
 
+static_assert(sizeof(Move) == 2, "Move must stay packed to 2 bytes");
+
+/**
+ * Fixed-capacity move list (stack-resident, no heap allocation)
+ *
+ * Capacity covers every hex x every tile value, the most any position
+ * can generate. Supports the std::vector subset used by the engines.
+ */
+class MoveList {
+public:
+    static constexpr int CAPACITY = NUM_HEXES * NUM_TILES_PER_PLAYER;
+
+    MoveList() : count(0) {}
+
+    void push_back(const Move& move) { moves[count++] = move; }
+    void clear() { count = 0; }
+
+    // Remove move at index by swapping in the last one (order not preserved)
+    void swapRemove(size_t index) { moves[index] = moves[--count]; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](size_t index) { return moves[index]; }
+    const Move& operator[](size_t index) const { return moves[index]; }
+
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+private:
+    Move moves[CAPACITY];
+    int count;
+};
+
 /**
  * Move with evaluation score (used by AI)
  */
@@ -0,0 +1,172 @@
+#ifndef HEXUKI_MOVE_GENERATOR_H
+#define HEXUKI_MOVE_GENERATOR_H
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include "core/bitboard.h"
+#include "core/move.h"
+#include "core/rules.h"
+#include "utils/constants.h"
+#include "utils/timer.h"
+
+namespace hexuki {
+
+/**
+ * Lazy move enumeration over (legal hex mask) x (unique tile mask)
+ *
+ * Legal moves are the cross product of the legal empty hexes and the
+ * distinct tile values the side to move still holds, so they can be
+ * counted, indexed and sampled without building a list:
+ * - count()      = popcount(hexes) * popcount(tiles)
+ * - nth(k)       = k-th move in generation order (hex-major, TILE_VALUES order)
+ * - random(rng)  = nth(uniform k), same draw as indexing a full MoveList
+ * - next(move)   = yields moves one at a time (stop early on a cutoff)
+ *
+ * Generation order matches HexukiBitboard::generateMoves, so index k
+ * names the same move either way. The generator snapshots the masks at
+ * construction; it does not follow later make/unmake calls.
+ *
+ * Anti-symmetry (when active) removes at most a whole hex set or a single
+ * move from the cross product:
+ * - Board currently mirrored: every center column move keeps it mirrored
+ * - One mismatched pair, one side empty: copying the other side's value
+ *   there mirrors the board; that one move is skipped by index
+ *
+ * MoveGenerator(board) reads the board's rule flags at runtime;
+ * MoveGenerator(board, Rules<F>()) folds them at compile time (the board
+ * must carry the same flags).
+ */
+class MoveGenerator {
+public:
+    explicit MoveGenerator(const HexukiBitboard& board)
+        : hexMask(board.getLegalHexMask())
+        , tileMask(tilePresence(board.getTileInventory(board.getCurrentPlayer())))
+        , tileCount(BitOps::popcount64(tileMask))
+        , excluded()
+        , excludedIndex(-1)
+        , hexesLeft(0)
+        , tilesLeft(0)
+        , currentHex(-1)
+    {
+        if (board.isAntiSymmetryActive()) {
+            excludeMirroringMoves(board);
+        }
+        hexesLeft = tileMask ? hexMask : 0;
+    }
+
+    template <uint8_t Flags>
+    MoveGenerator(const HexukiBitboard& board, Rules<Flags>)
+        : hexMask(Rules<Flags>::legalHexMask(board.getOccupiedMask()))
+        , tileMask(tilePresence(board.getTileInventory(board.getCurrentPlayer())))
+        , tileCount(BitOps::popcount64(tileMask))
+        , excluded()
+        , excludedIndex(-1)
+        , hexesLeft(0)
+        , tilesLeft(0)
+        , currentHex(-1)
+    {
+        assert(board.getRuleFlags() == Flags);
+        if constexpr (Rules<Flags>::ANTI_SYMMETRY) {
+            if (board.isAntiSymmetryActive()) {
+                excludeMirroringMoves(board);
+            }
+        }
+        hexesLeft = tileMask ? hexMask : 0;
+    }
+
+    // Number of legal moves
+    int count() const { return BitOps::popcount(hexMask) * tileCount - (excludedIndex >= 0); }
+    bool empty() const { return count() == 0; }
+
+    // Is move one of the legal moves? (validates TT and killer moves before generating)
+    bool contains(const Move& move) const {
+        if (move.hexId < 0 || move.hexId >= NUM_HEXES || move.tileValue > MAX_TILE_VALUE) return false;
+        int slot = TILE_SLOTS[move.tileValue];
+        return slot >= 0 && (hexMask & (1u << move.hexId))
+            && (tileMask & (1ull << (slot * TILE_COUNT_BITS))) && move != excluded;
+    }
+
+    // k-th legal move in generation order (0 <= k < count())
+    Move nth(int k) const {
+        if (excludedIndex >= 0 && k >= excludedIndex) k++;
+        int hexId = BitOps::selectBit(hexMask, k / tileCount);
+        int slot = BitOps::selectBit64(tileMask, k % tileCount) / TILE_COUNT_BITS;
+        return Move(hexId, TILE_VALUES[slot]);
+    }
+
+    // Uniformly random legal move (count() must be > 0)
+    template <typename Rng>
+    Move random(Rng& rng) const {
+        std::uniform_int_distribution<size_t> dist(0, static_cast<size_t>(count()) - 1);
+        return nth(static_cast<int>(dist(rng)));
+    }
+
+    // Yield the next move; returns false once every move has been produced
+    bool next(Move& move) {
+        do {
+            if (tilesLeft == 0) {
+                if (hexesLeft == 0) return false;
+                currentHex = BitOps::countTrailingZeros(hexesLeft);
+                hexesLeft &= hexesLeft - 1;
+                tilesLeft = tileMask;
+            }
+            int slot = BitOps::countTrailingZeros64(tilesLeft) / TILE_COUNT_BITS;
+            tilesLeft &= tilesLeft - 1;
+            move = Move(currentHex, TILE_VALUES[slot]);
+        } while (move == excluded);
+        return true;
+    }
+
+    // Materialize the remaining moves
+    void fill(MoveList& moves) {
+        moves.clear();
+        Move move;
+        while (next(move)) {
+            moves.push_back(move);
+        }
+    }
+
+    uint32_t getHexMask() const { return hexMask; }
+    uint64_t getTileMask() const { return tileMask; }  // tilePresence bits (one per held value)
+
+private:
+    void excludeMirroringMoves(const HexukiBitboard& board) {
+        uint32_t mismatch = board.getMirrorMismatch();
+        if (mismatch == 0) {
+            hexMask &= ~CENTER_COLUMN_MASK;
+            return;
+        }
+
+        // Exactly one mismatched pair (two bits) with an empty, legal side
+        uint32_t emptySide = mismatch & hexMask;
+        if (BitOps::popcount(mismatch) != 2 || emptySide == 0) return;
+
+        int hexId = BitOps::countTrailingZeros(emptySide);
+        int value = board.getTileValue(VERTICAL_MIRROR_PAIRS[hexId]);
+        if (TILE_SLOTS[value] < 0) return;  // Puzzle tile nobody can hold
+        uint64_t tileBit = 1ull << (TILE_SLOTS[value] * TILE_COUNT_BITS);
+        if (!(tileMask & tileBit)) return;
+
+        excluded = Move(hexId, value);
+        excludedIndex = BitOps::popcount(hexMask & ((1u << hexId) - 1)) * tileCount
+                      + BitOps::popcount64(tileMask & (tileBit - 1));
+    }
+
+    uint32_t hexMask;   // Legal empty hexes
+    uint64_t tileMask;  // Low bit of each nonzero inventory nibble
+    int tileCount;
+
+    // Move removed by the anti-symmetry rule (excludedIndex = -1 if none)
+    Move excluded;
+    int excludedIndex;
+
+    // Enumeration cursor
+    uint32_t hexesLeft;
+    uint64_t tilesLeft;
+    int currentHex;
+};
+
+} // namespace hexuki
+
+#endif // HEXUKI_MOVE_GENERATOR_H
@@ -0,0 +1,77 @@
+#ifndef HEXUKI_NOTATION_H
+#define HEXUKI_NOTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "core/move.h"
+#include "core/packed_position.h"
+#include "core/rules.h"
+
+namespace hexuki {
+
+class HexukiBitboard;
+
+/**
+ * Allocation-free parsers for move and position notation
+ *
+ * Hand-written scanners over std::string_view: no regex, streams,
+ * substrings or exceptions. Positions parse straight into a
+ * PackedPosition, so loading a board hashes once at the end
+ * (HexukiBitboard::unpack) instead of once per placed tile.
+ *
+ * Errors come back as a ParseStatus: a static message and the byte
+ * offset where parsing stopped.
+ */
+struct ParseStatus {
+    const char* error = nullptr;  // nullptr = success
+    size_t offset = 0;            // Byte offset of the problem in the input
+
+    bool ok() const { return error == nullptr; }
+};
+
+// Move: "h6t5" (hex 6, tile 5)
+ParseStatus parseMove(std::string_view text, Move& move);
+
+// Position: "h0:1,h4:5,h9:1|p1:2,3,4|p2:6,7,8|turn:1" (HexukiBitboard::savePosition)
+// - Sections in any order, empty sections skipped
+// - Missing p1/p2 = one of each tile, missing turn = player 1
+// - Tile values must be TILE_VALUES; hands hold up to PackedPosition::MAX_TILES
+// position is only written on success.
+ParseStatus parsePosition(std::string_view text, PackedPosition& position,
+                          uint8_t ruleFlags = DEFAULT_RULE_FLAGS);
+
+// Game record (HexukiBitboard::toNotation): optional starting position,
+// then whitespace-separated moves. Replays onto board under its rule flags,
+// rejecting illegal moves; board is only written on success. Without a
+// starting position the game starts from board.reset().
+ParseStatus parseGame(std::string_view text, HexukiBitboard& board);
+
+// ============================================================================
+// Bulk loading
+// ============================================================================
+
+// A line of a bulk buffer that failed to parse (1-based line number)
+struct LineParseError {
+    size_t line;
+    ParseStatus status;
+};
+
+/**
+ * Parse newline-separated positions (LF or CRLF; blank lines skipped)
+ *
+ * Appends one entry per good line and returns how many were added. Bad
+ * lines are skipped and reported in errors when given. The only
+ * allocations are the output vectors growing.
+ */
+size_t parsePositions(std::string_view buffer, std::vector<PackedPosition>& positions,
+                      std::vector<LineParseError>* errors = nullptr,
+                      uint8_t ruleFlags = DEFAULT_RULE_FLAGS);
+size_t parsePositions(std::string_view buffer, std::vector<HexukiBitboard>& boards,
+                      std::vector<LineParseError>* errors = nullptr,
+                      uint8_t ruleFlags = DEFAULT_RULE_FLAGS);
+
+} // namespace hexuki
+
+#endif // HEXUKI_NOTATION_H
@@ -0,0 +1,141 @@
+#ifndef HEXUKI_PACKED_POSITION_H
+#define HEXUKI_PACKED_POSITION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "utils/constants.h"
+#include "utils/timer.h"
+
+namespace hexuki {
+
+/**
+ * Fixed-width binary position (16 bytes)
+ *
+ * Exact key for caches, record type for datasets and compact payload for
+ * the WASM/CLI interfaces (see HexukiBitboard::pack/unpack). Layout, low
+ * bit first across lo then hi:
+ * - bits   0-75:  19 cells x 4 bits, TILE_VALUES slot + 1 (0 = empty)
+ * - bits  76-98:  P1 inventory, 23 bits
+ * - bits  99-121: P2 inventory, 23 bits
+ * - bit   122:    side to move (0 = P1, 1 = P2)
+ * - bits 123-126: rule flags (RuleFlag bits)
+ *
+ * An inventory is stored unary: for each TILE_VALUES slot, one set bit per
+ * tile held, with a zero between slots. That fits any hand of up to
+ * MAX_TILES tiles (a game deals 9); larger puzzle hands are cut to
+ * MAX_TILES in TILE_VALUES order.
+ *
+ * Equal positions (same tiles, hands, side and rules) pack to equal
+ * values, so ==, < and std::hash work directly on the two words.
+ */
+struct PackedPosition {
+    static constexpr int CELL_BITS = 4;
+    static constexpr int INVENTORY_BITS = 23;
+    static constexpr int MAX_TILES = INVENTORY_BITS - (NUM_TILES_PER_PLAYER - 1);  // 15
+
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    // Cells: TILE_VALUES slot + 1, 0 = empty
+    int getCell(int hexId) const {
+        int bit = hexId * CELL_BITS;
+        uint64_t word = bit < 64 ? lo : hi;
+        return static_cast<int>((word >> (bit & 63)) & CELL_MASK);
+    }
+    void setCell(int hexId, int cell) {
+        int bit = hexId * CELL_BITS;
+        uint64_t& word = bit < 64 ? lo : hi;
+        word = (word & ~(CELL_MASK << (bit & 63))) | (static_cast<uint64_t>(cell) << (bit & 63));
+    }
+
+    // Inventories in HexukiBitboard's packed-count form (see TILE_COUNT_BITS)
+    uint64_t getInventory(int player) const {
+        return decodeInventory(field(inventoryShift(player), INVENTORY_BITS));
+    }
+    void setInventory(int player, uint64_t inventory) {
+        setField(inventoryShift(player), INVENTORY_BITS, encodeInventory(inventory));
+    }
+
+    int getCurrentPlayer() const { return field(SIDE_SHIFT, 1) ? PLAYER_2 : PLAYER_1; }
+    void setCurrentPlayer(int player) { setField(SIDE_SHIFT, 1, player == PLAYER_2 ? 1 : 0); }
+
+    uint8_t getRuleFlags() const { return static_cast<uint8_t>(field(RULES_SHIFT, RULES_BITS)); }
+    void setRuleFlags(uint8_t flags) { setField(RULES_SHIFT, RULES_BITS, flags); }
+
+    // 32 lowercase hex digits (hi word first); fromHex throws std::invalid_argument
+    std::string toHex() const;
+    static PackedPosition fromHex(const std::string& text);
+
+    size_t hash() const {
+        // Fold both words, then finalize (splitmix64)
+        uint64_t h = lo ^ (hi * 0x9E3779B97F4A7C15ull);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<size_t>(h ^ (h >> 31));
+    }
+
+    bool operator==(const PackedPosition& other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const PackedPosition& other) const { return !(*this == other); }
+    bool operator<(const PackedPosition& other) const {
+        return hi != other.hi ? hi < other.hi : lo < other.lo;
+    }
+
+private:
+    static constexpr uint64_t CELL_MASK = (1ull << CELL_BITS) - 1;
+    static constexpr int P1_INVENTORY_SHIFT = NUM_HEXES * CELL_BITS - 64;  // Offsets within hi
+    static constexpr int SIDE_SHIFT = P1_INVENTORY_SHIFT + 2 * INVENTORY_BITS;
+    static constexpr int RULES_SHIFT = SIDE_SHIFT + 1;
+    static constexpr int RULES_BITS = 4;
+
+    static_assert(NUM_HEXES * CELL_BITS > 64 && RULES_SHIFT + RULES_BITS <= 64, "Layout must fit in 128 bits");
+    static_assert(NUM_TILES_PER_PLAYER < (1 << CELL_BITS), "Cells hold slot + 1");
+
+    static int inventoryShift(int player) {
+        return P1_INVENTORY_SHIFT + (player == PLAYER_2 ? INVENTORY_BITS : 0);
+    }
+    uint64_t field(int shift, int bits) const { return (hi >> shift) & ((1ull << bits) - 1); }
+    void setField(int shift, int bits, uint64_t value) {
+        uint64_t mask = ((1ull << bits) - 1) << shift;
+        hi = (hi & ~mask) | ((value << shift) & mask);
+    }
+
+    // Counts -> unary runs separated by zeros (slot 0 in the low bits)
+    static uint64_t encodeInventory(uint64_t inventory) {
+        uint64_t bits = 0;
+        int pos = 0;
+        int budget = MAX_TILES;
+        for (int slot = 0; slot < NUM_TILES_PER_PLAYER; slot++) {
+            int count = static_cast<int>((inventory >> (slot * TILE_COUNT_BITS)) & TILE_COUNT_MASK);
+            if (count > budget) count = budget;
+            budget -= count;
+            bits |= ((1ull << count) - 1) << pos;
+            pos += count + 1;
+        }
+        return bits;
+    }
+    static uint64_t decodeInventory(uint64_t bits) {
+        uint64_t inventory = 0;
+        for (int slot = 0; slot < NUM_TILES_PER_PLAYER - 1; slot++) {
+            int count = BitOps::countTrailingZeros64(~bits);
+            inventory |= static_cast<uint64_t>(count) << (slot * TILE_COUNT_BITS);
+            bits >>= count + 1;
+        }
+        inventory |= static_cast<uint64_t>(BitOps::popcount64(bits)) << ((NUM_TILES_PER_PLAYER - 1) * TILE_COUNT_BITS);
+        return inventory;
+    }
+};
+
+static_assert(sizeof(PackedPosition) == 16, "PackedPosition must stay 16 bytes");
+
+} // namespace hexuki
+
+namespace std {
+template <>
+struct hash<hexuki::PackedPosition> {
+    size_t operator()(const hexuki::PackedPosition& position) const { return position.hash(); }
+};
+} // namespace std
+
+#endif // HEXUKI_PACKED_POSITION_H
@@ -0,0 +1,66 @@
+#ifndef HEXUKI_PERFT_H
+#define HEXUKI_PERFT_H
+
+#include <cstdint>
+#include <vector>
+#include "core/bitboard.h"
+#include "core/move.h"
+
+namespace hexuki {
+
+/**
+ * Perft: count the leaf nodes of the move tree to a fixed depth
+ *
+ * The regression oracle for move generation (any change that alters a
+ * count changed the legal move set) and its raw throughput benchmark.
+ * A leaf is a position reached after exactly 'depth' moves; lines that
+ * end earlier (board full, side to move stuck) contribute nothing.
+ *
+ * - Bulk counting: the last ply is counted with MoveGenerator::count()
+ *   instead of making every move
+ * - Unique positions: leaf positions are made and their 128-bit keys
+ *   collected (Zobrist hash or symmetry-canonical hash), so transpositions
+ *   count once
+ * - Threads: root moves are handed out to worker threads one at a time;
+ *   each works on its own copy of the board
+ *
+ * Kernels run under the board's rule flags (dispatchRules).
+ */
+
+// Which key identifies a position when counting unique leaves
+enum class PerftKey {
+    NONE,       // Don't count unique positions
+    HASH,       // getHash128()
+    CANONICAL,  // getHash128(getCanonicalSymmetry()): symmetric positions count once
+};
+
+struct PerftOptions {
+    int depth = 1;
+    int threads = 1;  // Worker threads for the root moves (<= 1 = this thread)
+    bool bulk = true;  // Count the last ply without making it (ignored when counting unique positions)
+    PerftKey unique = PerftKey::NONE;
+};
+
+struct PerftDivide {
+    Move move;       // Root move
+    uint64_t nodes;  // Leaves below it
+};
+
+struct PerftResult {
+    uint64_t nodes = 0;            // Leaf nodes at depth
+    uint64_t uniquePositions = 0;  // Distinct leaf keys (PerftKey::NONE: 0)
+    std::vector<PerftDivide> divide;  // Per root move, in generation order (depth >= 1)
+    double seconds = 0.0;
+
+    double nodesPerSecond() const { return seconds > 0.0 ? nodes / seconds : 0.0; }
+};
+
+// Leaf count to depth on this thread (board is restored on return)
+uint64_t perft(HexukiBitboard& board, int depth, bool bulk = true);
+
+// Full run: divide, optional unique positions, threads, timing
+PerftResult runPerft(const HexukiBitboard& board, const PerftOptions& options);
+
+} // namespace hexuki
+
+#endif // HEXUKI_PERFT_H
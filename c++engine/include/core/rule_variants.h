@@ -0,0 +1,52 @@
+#ifndef HEXUKI_RULE_VARIANTS_H
+#define HEXUKI_RULE_VARIANTS_H
+
+#include <cstdint>
+#include <string>
+#include "core/bitboard.h"
+#include "core/rules.h"
+
+namespace hexuki {
+
+/**
+ * A named Hexuki variant: rule flags plus starting inventories
+ *
+ * Mirrors the JS engines, so one binary can play all of them:
+ * - standard:      engine default (no anti-symmetry)
+ * - anti-symmetry: production rules (hexuki_game_engine_v2.js)
+ * - free-opening:  P1's first tile may go anywhere (hexuki_game_engine_free_opening.js)
+ * - asymmetric:    each player gets 9 random values, duplicates allowed; no
+ *                  anti-symmetry, even for identical deals
+ *                  (hexuki_game_engine_asymmetric.js)
+ * - no-chain:      adjacency only, no chain length rule
+ * - empty-start:   no center tile; the first tile goes anywhere
+ *
+ * Variants do not cover tile sets: the values themselves come from
+ * TILE_VALUES, so switching to another set (constants.h) still needs a
+ * rebuild. Variants only pick how many of each value a player starts with.
+ */
+struct RuleVariant {
+    const char* name;
+    const char* description;
+    uint8_t flags;        // RuleFlag bits
+    uint64_t p1Tiles;     // Starting inventories (packed, see TILE_COUNT_BITS)
+    uint64_t p2Tiles;
+    bool randomTiles;     // Deal random inventories instead (seeded)
+
+    // Set up a new game of this variant on board (seed only used for random deals)
+    void setup(HexukiBitboard& board, uint32_t seed = 0) const;
+};
+
+/**
+ * Registry of the variants above, looked up by name at runtime
+ */
+class RuleRegistry {
+public:
+    static int count();
+    static const RuleVariant& get(int index);
+    static const RuleVariant* find(const std::string& name);  // nullptr if unknown
+};
+
+} // namespace hexuki
+
+#endif // HEXUKI_RULE_VARIANTS_H
@@ -0,0 +1,116 @@
+#ifndef HEXUKI_RULES_H
+#define HEXUKI_RULES_H
+
+#include <cstdint>
+#include "core/legal_mask_table.h"
+#include "utils/constants.h"
+
+namespace hexuki {
+
+// ============================================================================
+// Rule flags
+// ============================================================================
+
+// Placement/legality rules that vary between Hexuki variants. A board carries
+// its flags at runtime; Rules<Flags> fixes them at compile time for hot loops.
+enum RuleFlag : uint8_t {
+    RULE_CENTER_START     = 1 << 0,  // Game starts with STARTING_TILE on CENTER_HEX
+    RULE_FREE_OPENING     = 1 << 1,  // First placement may go on any empty hex
+    RULE_ANTI_SYMMETRY    = 1 << 2,  // No move may leave the board mirrored (JS v2)
+    RULE_CHAIN_CONSTRAINT = 1 << 3,  // Chain length rule (off = adjacency only)
+};
+
+constexpr int NUM_RULE_FLAGS = 4;
+constexpr uint8_t ALL_RULE_FLAGS = (1u << NUM_RULE_FLAGS) - 1;
+constexpr uint8_t DEFAULT_RULE_FLAGS = RULE_CENTER_START | RULE_CHAIN_CONSTRAINT;
+
+// Occupancy a game starts from
+constexpr uint32_t startingOccupancy(uint8_t flags) {
+    return (flags & RULE_CENTER_START) ? (1u << CENTER_HEX) : 0u;
+}
+
+// Is the first placement unrestricted? (always true for an empty start:
+// there is nothing to be adjacent to)
+constexpr bool hasFreeOpening(uint8_t flags) {
+    return (flags & RULE_FREE_OPENING) || !(flags & RULE_CENTER_START);
+}
+
+// Legal empty hexes under runtime flags (tables must be initialized)
+inline uint32_t legalHexMask(uint32_t hexOccupied, uint8_t flags) {
+    if (hasFreeOpening(flags) && hexOccupied == startingOccupancy(flags)) {
+        return ALL_HEXES_MASK & ~hexOccupied;
+    }
+    return (flags & RULE_CHAIN_CONSTRAINT) ? LegalMaskTable::lookup(hexOccupied)
+                                           : LegalMaskTable::lookupAdjacent(hexOccupied);
+}
+
+// ============================================================================
+// Compile-time rules policy
+// ============================================================================
+
+/**
+ * Rules policy: one type per flag combination
+ *
+ * Search and rollout kernels take a Rules<Flags> tag so every rule check
+ * folds to a constant (if constexpr) instead of a branch per node.
+ * dispatchRules() maps a board's runtime flags to the matching
+ * instantiation once, at the kernel's entry point:
+ *
+ *   dispatchRules(board.getRuleFlags(), [&](auto rules) {
+ *       return search(board, rules);  // MoveGenerator(board, rules) inside
+ *   });
+ *
+ * The tile set is not part of the policy: inventories are board data and
+ * the kernels never branch on them (see RuleVariant for per-variant sets).
+ */
+template <uint8_t Flags>
+struct Rules {
+    static_assert((Flags & ~ALL_RULE_FLAGS) == 0, "Unknown rule flag");
+
+    static constexpr uint8_t FLAGS = Flags;
+    static constexpr bool CENTER_START = (Flags & RULE_CENTER_START) != 0;
+    static constexpr bool FREE_OPENING = hasFreeOpening(Flags);
+    static constexpr bool ANTI_SYMMETRY = (Flags & RULE_ANTI_SYMMETRY) != 0;
+    static constexpr bool CHAIN_CONSTRAINT = (Flags & RULE_CHAIN_CONSTRAINT) != 0;
+
+    // Same result as legalHexMask(hexOccupied, FLAGS)
+    static uint32_t legalHexMask(uint32_t hexOccupied) {
+        if constexpr (FREE_OPENING) {
+            if (hexOccupied == startingOccupancy(FLAGS)) return ALL_HEXES_MASK & ~hexOccupied;
+        }
+        if constexpr (CHAIN_CONSTRAINT) {
+            return LegalMaskTable::lookup(hexOccupied);
+        } else {
+            return LegalMaskTable::lookupAdjacent(hexOccupied);
+        }
+    }
+};
+
+using StandardRules = Rules<DEFAULT_RULE_FLAGS>;
+
+// Call fn(Rules<flags>()) with the instantiation matching runtime flags
+template <typename Fn>
+decltype(auto) dispatchRules(uint8_t flags, Fn&& fn) {
+    switch (flags & ALL_RULE_FLAGS) {
+        case 0:  return fn(Rules<0>());
+        case 1:  return fn(Rules<1>());
+        case 2:  return fn(Rules<2>());
+        case 3:  return fn(Rules<3>());
+        case 4:  return fn(Rules<4>());
+        case 5:  return fn(Rules<5>());
+        case 6:  return fn(Rules<6>());
+        case 7:  return fn(Rules<7>());
+        case 8:  return fn(Rules<8>());
+        case 9:  return fn(Rules<9>());
+        case 10: return fn(Rules<10>());
+        case 11: return fn(Rules<11>());
+        case 12: return fn(Rules<12>());
+        case 13: return fn(Rules<13>());
+        case 14: return fn(Rules<14>());
+        default: return fn(Rules<15>());
+    }
+}
+
+} // namespace hexuki
+
+#endif // HEXUKI_RULES_H
@@ -0,0 +1,47 @@
+#ifndef HEXUKI_SCORE_BOUNDS_H
+#define HEXUKI_SCORE_BOUNDS_H
+
+#include <cstdint>
+#include "utils/constants.h"
+#include "utils/timer.h"
+
+namespace hexuki {
+
+/**
+ * Exact bounds on each player's final score from the current position
+ *
+ * A final score is a sum of chain products (an empty hex counts as 1):
+ * - Lower: the current score. Every tile is >= 1, so placing one never
+ *   lowers a product, and the game may end with hexes still empty.
+ * - Upper: each chain's product times the product of the k largest tiles
+ *   left in either hand, k = the chain's empty hexes. Chains are bounded
+ *   independently, so a tile may be counted on several of them.
+ *
+ * Any line played from here ends inside the bounds, and so does the
+ * current score difference, which depth-limited search uses at its leaves.
+ * compute() reads only state the board keeps incrementally (chain products,
+ * totals, occupancy, packed hands) and costs one pass over the tile slots.
+ */
+struct ScoreBounds {
+    int32_t lower[2];  // [player - 1]
+    int32_t upper[2];
+
+    // Range of the final margin (player's score minus the opponent's)
+    int marginLower(int player) const { return lower[player - 1] - upper[2 - player]; }
+    int marginUpper(int player) const { return upper[player - 1] - lower[2 - player]; }
+
+    // PLAYER_1 / PLAYER_2 if every continuation ends in their win, 0 if still open
+    int decidedWinner() const {
+        if (marginLower(PLAYER_1) > 0) return PLAYER_1;
+        if (marginUpper(PLAYER_1) < 0) return PLAYER_2;
+        return 0;
+    }
+
+    static ScoreBounds compute(const int32_t (&chainProducts)[2][CHAINS_PER_PLAYER],
+                               const int32_t (&scores)[2],
+                               uint32_t occupied, uint64_t p1Tiles, uint64_t p2Tiles);
+};
+
+} // namespace hexuki
+
+#endif // HEXUKI_SCORE_BOUNDS_H
@@ -2,6 +2,7 @@
 #define HEXUKI_ZOBRIST_H
 
 #include <cstdint>
+#include "core/rules.h"
 #include "utils/constants.h"
 
 namespace hexuki {
@@ -9,42 +10,141 @@ namespace hexuki {
 // Forward declaration
 class HexukiBitboard;
 
+/**
+ * Zobrist keys for a board of NumHexes hexes, generated at compile time
+ *
+ * Keys come from a splitmix64 stream over a fixed seed, drawn in a fixed
+ * order (tile placements hex by hex, side to move, tile counts, rule
+ * flags), so they are the same in every build and every run.
+ *
+ * Tile count keys are prefix XORs: tileCount[p][v][c] is the XOR of c
+ * random "one more tile" keys (count 0 hashes to 0). Taking or returning
+ * one tile is then a single XOR, tileTake[p][v][c] (c = the larger count).
+ */
+template <int NumHexes>
+struct ZobristKeys {
+    uint64_t tile[NumHexes][MAX_TILE_VALUE + 1];                   // [hexId][tileValue]
+    uint64_t player[2];                                            // [player-1]
+    uint64_t tileCount[2][MAX_TILE_VALUE + 1][MAX_TILE_COUNT + 1];  // [player-1][tileValue][count]
+    uint64_t tileTake[2][MAX_TILE_VALUE + 1][MAX_TILE_COUNT + 1];   // tileCount[c] ^ tileCount[c-1]
+    uint64_t rules[8];                                             // [RuleFlag bit]
+
+    static constexpr ZobristKeys generate(uint64_t seed) {
+        ZobristKeys keys{};
+        uint64_t state = seed;
+        auto next = [&state]() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        };
+
+        for (int hexId = 0; hexId < NumHexes; hexId++) {
+            for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+                keys.tile[hexId][TILE_VALUES[i]] = next();
+            }
+        }
+        for (int p = 0; p < 2; p++) {
+            keys.player[p] = next();
+        }
+        for (int p = 0; p < 2; p++) {
+            for (int tileVal = 1; tileVal <= MAX_TILE_VALUE; tileVal++) {
+                for (int count = 1; count <= MAX_TILE_COUNT; count++) {
+                    keys.tileTake[p][tileVal][count] = next();
+                    keys.tileCount[p][tileVal][count] = keys.tileCount[p][tileVal][count - 1] ^ keys.tileTake[p][tileVal][count];
+                }
+            }
+        }
+        for (int bit = 0; bit < NUM_RULE_FLAGS; bit++) {
+            keys.rules[bit] = next();
+        }
+        return keys;
+    }
+};
+
+constexpr uint64_t ZOBRIST_SEED = 0x1234567890ABCDEFull;
+constexpr uint64_t ZOBRIST_SEED_HIGH = 0xFEDCBA0987654321ull;  // Second key of a 128-bit hash
+
+// The key tables, one constant per board size (HexBoard<Radius> uses these too)
+template <int NumHexes>
+inline constexpr ZobristKeys<NumHexes> ZOBRIST_KEYS = ZobristKeys<NumHexes>::generate(ZOBRIST_SEED);
+template <int NumHexes>
+inline constexpr ZobristKeys<NumHexes> ZOBRIST_KEYS_HIGH = ZobristKeys<NumHexes>::generate(ZOBRIST_SEED_HIGH);
+
+// 128-bit position key: lo = Zobrist::hash, hi = Zobrist::hashHigh
+struct HashKey128 {
+    uint64_t lo;
+    uint64_t hi;
+
+    bool operator==(const HashKey128& other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const HashKey128& other) const { return !(*this == other); }
+};
+
 /**
  * Zobrist hashing for game positions
  *
  * Used for transposition tables in minimax:
  * - Each position gets a unique 64-bit hash
  * - Same position = same hash (deterministic)
- * - Fast incremental updates (XOR operations)
+ * - Fast incremental updates (XOR operations): a move XORs its placement,
+ *   the side to move and the mover's tile count, so a board's incremental
+ *   hash always equals hash(board), however the position was reached or
+ *   loaded. Build with HEXUKI_VERIFY_HASH to check that after every move.
+ * - Symmetric hashes: hash(board, s) is the hash of the position after
+ *   board symmetry s (see SYMMETRY_HEX_MAP), so equivalent positions can
+ *   share one canonical key
+ * - Rule flags other than the defaults are hashed too, so a transposition
+ *   table never mixes positions played under different rules
+ * - 128-bit keys: hashHigh() is an independent second 64-bit key from its
+ *   own tables, computed on demand (perft counts unique positions by it)
+ *
+ * The tables are compile-time constants, so lookups never check for
+ * initialization.
  */
 class Zobrist {
 public:
-    // Initialize random hash tables (call once at program start)
-    static void initialize();
+    // Nothing to set up any more (tables are constexpr); kept for callers
+    static void initialize() {}
 
     // Get hash for a tile placement
-    static uint64_t getTileHash(int hexId, int tileValue);
+    static uint64_t getTileHash(int hexId, int tileValue) { return KEYS.tile[hexId][tileValue]; }
 
     // Get hash for player-to-move
-    static uint64_t getPlayerHash(int player);
+    static uint64_t getPlayerHash(int player) { return KEYS.player[player - 1]; }
+
+    // Hash for holding 'count' tiles of a value (0 for none)
+    static uint64_t getTileCountHash(int player, int tileValue, int count) {
+        return KEYS.tileCount[player - 1][tileValue][count];
+    }
+
+    // Change in hash when a player's count of a value goes from count to count - 1 (or back)
+    static uint64_t getTileTakeHash(int player, int tileValue, int count) {
+        return KEYS.tileTake[player - 1][tileValue][count];
+    }
+
+    // Hash for a set of rule flags (0 for DEFAULT_RULE_FLAGS)
+    static uint64_t getRulesHash(uint8_t ruleFlags) { return rulesHash(KEYS, ruleFlags); }
 
     // Calculate full hash for a board state
     static uint64_t hash(const HexukiBitboard& board);
 
-private:
-    // Hash tables (initialized with random numbers)
-    // Sized for MAX_TILE_VALUE to handle any tile values (e.g., if using tiles 2,4,6,8... up to 18)
-    static uint64_t tileHashes[NUM_HEXES][MAX_TILE_VALUE + 1];  // [hexId][tileValue]
-    static uint64_t playerHashes[2];                             // [player-1]
+    // Full hash of the board transformed by symmetry (0 = identity, same as hash(board))
+    static uint64_t hash(const HexukiBitboard& board, int symmetry);
+
+    // Second, independent 64-bit key (upper half of a 128-bit hash)
+    static uint64_t hashHigh(const HexukiBitboard& board, int symmetry = 0);
 
-    // Tile count hashes for available tiles (supports duplicates)
-    // tileCountHashes[player][tileValue][count] = hash for having 'count' of 'tileValue' for 'player'
-    // player: 0 = P1, 1 = P2
-    // tileValue: 1-9
-    // count: 0-9 (max 9 of any tile value)
-    static uint64_t tileCountHashes[2][MAX_TILE_VALUE + 1][10];
+    static constexpr const ZobristKeys<NUM_HEXES>& KEYS = ZOBRIST_KEYS<NUM_HEXES>;
+    static constexpr const ZobristKeys<NUM_HEXES>& KEYS_HIGH = ZOBRIST_KEYS_HIGH<NUM_HEXES>;
 
-    static bool initialized;
+    template <int NumHexes>
+    static constexpr uint64_t rulesHash(const ZobristKeys<NumHexes>& keys, uint8_t ruleFlags) {
+        uint64_t h = 0;
+        for (int bit = 0; bit < NUM_RULE_FLAGS; bit++) {
+            if ((ruleFlags ^ DEFAULT_RULE_FLAGS) & (1u << bit)) h ^= keys.rules[bit];
+        }
+        return h;
+    }
 };
 
 } // namespace hexuki
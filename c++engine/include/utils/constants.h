@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <array>
+#include "utils/hex_geometry.h"
 
 namespace hexuki {
 
@@ -13,6 +14,7 @@ namespace hexuki {
 // Game constants
 constexpr int NUM_HEXES = 19;
 constexpr int NUM_TILES_PER_PLAYER = 9;  // ALWAYS 9 tiles per player (game rule)
+constexpr int MAX_PLIES = NUM_HEXES;     // One placement per hex (puzzles may leave the center empty)
 constexpr int CENTER_HEX = 9;            // Center hex (starts with value 1)
 constexpr int STARTING_TILE = 1;         // Value of starting tile at center
 constexpr int MAX_MOVES = 18;            // All non-center hexes
@@ -52,154 +54,408 @@ constexpr int getMaxTileValue() {
 
 constexpr int MAX_TILE_VALUE = getMaxTileValue();
 
+// ============================================================================
+// PACKED TILE INVENTORY
+// ============================================================================
+
+// A player's remaining tiles are stored as one 4-bit count per tile slot
+// (slot i = TILE_VALUES[i]) in a uint64_t, so duplicates like [3,3,3,3]
+// from puzzles are supported and the board stays trivially copyable.
+constexpr int TILE_COUNT_BITS = 4;
+constexpr uint64_t TILE_COUNT_MASK = (1ull << TILE_COUNT_BITS) - 1;
+constexpr int MAX_TILE_COUNT = static_cast<int>(TILE_COUNT_MASK);  // Max copies of one value
+
+static_assert(NUM_TILES_PER_PLAYER * TILE_COUNT_BITS <= 64, "Tile inventory must fit in a uint64_t");
+
+// TILE_SLOTS[value] = slot of a tile value in TILE_VALUES (-1 if not a tile value)
+constexpr std::array<int8_t, MAX_TILE_VALUE + 1> calculateTileSlots() {
+    std::array<int8_t, MAX_TILE_VALUE + 1> slots{};
+    for (int value = 0; value <= MAX_TILE_VALUE; value++) slots[value] = -1;
+    for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) slots[TILE_VALUES[i]] = static_cast<int8_t>(i);
+    return slots;
+}
+
+constexpr std::array<int8_t, MAX_TILE_VALUE + 1> TILE_SLOTS = calculateTileSlots();
+
+// One of each tile value (standard starting inventory)
+constexpr uint64_t calculateFullTileInventory() {
+    uint64_t inventory = 0;
+    for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+        inventory |= (1ull << (i * TILE_COUNT_BITS));
+    }
+    return inventory;
+}
+
+constexpr uint64_t FULL_TILE_INVENTORY = calculateFullTileInventory();
+
+// Low bit of every count field (used to turn counts into a "slot present" mask)
+constexpr uint64_t TILE_COUNT_LOW_BITS = FULL_TILE_INVENTORY;
+
+// Low bit of each non-empty count field set (one bit per available tile value)
+constexpr uint64_t tilePresence(uint64_t inventory) {
+    return (inventory | (inventory >> 1) | (inventory >> 2) | (inventory >> 3)) & TILE_COUNT_LOW_BITS;
+}
+
 // Players
 constexpr int PLAYER_1 = 1;
 constexpr int PLAYER_2 = 2;
 constexpr int NO_PLAYER = 0;
 
 // ============================================================================
-// HEX GRID LAYOUT (row/col coordinates)
-// ============================================================================
-
-struct HexPosition {
-    int id;
-    int row;
-    int col;
-};
-
-// Hex positions (from JavaScript lines 14-34)
-constexpr HexPosition HEX_POSITIONS[NUM_HEXES] = {
-    {0,  0, 2},
-    {1,  1, 1},
-    {2,  1, 3},
-    {3,  2, 0},
-    {4,  2, 2},
-    {5,  2, 4},
-    {6,  3, 1},
-    {7,  3, 3},
-    {8,  4, 0},
-    {9,  4, 2},  // CENTER
-    {10, 4, 4},
-    {11, 5, 1},
-    {12, 5, 3},
-    {13, 6, 0},
-    {14, 6, 2},
-    {15, 6, 4},
-    {16, 7, 1},
-    {17, 7, 3},
-    {18, 8, 2}
-};
-
-// ============================================================================
-// ADJACENCY DIRECTIONS (row/col offsets)
-// ============================================================================
-
-struct Direction {
-    int dr;  // Row offset
-    int dc;  // Column offset
-};
-
-// 6 hex directions (from JavaScript lines 117-124)
-constexpr Direction HEX_DIRECTIONS[6] = {
-    {-2,  0},  // UP
-    {-1,  1},  // UPRIGHT
-    { 1,  1},  // DOWNRIGHT
-    { 2,  0},  // DOWN
-    { 1, -1},  // DOWNLEFT
-    {-1, -1}   // UPLEFT
-};
+// HEX GRID LAYOUT (generated from the board radius, see utils/hex_geometry.h)
+// ============================================================================
+
+// The standard board: radius 2 (19 hexes). The tables below are copies of
+// HexGeometry<BOARD_RADIUS>, kept as the engine's fixed-size fast path
+// (32-bit masks, LegalMaskTable); HexBoard<Radius> plays the larger boards.
+constexpr int BOARD_RADIUS = 2;
+using BoardGeometry = HexGeometry<BOARD_RADIUS>;
+static_assert(BoardGeometry::NUM_HEXES == NUM_HEXES, "NUM_HEXES must match the board radius");
+static_assert(BoardGeometry::CENTER_HEX == CENTER_HEX, "CENTER_HEX must match the board radius");
+
+// Hex positions (JavaScript lines 14-34): rows 0-8, columns 0-4
+constexpr std::array<HexPosition, NUM_HEXES> HEX_POSITIONS = BoardGeometry::HEX_POSITIONS;
 
 // ============================================================================
 // VERTICAL MIRROR PAIRS (for anti-symmetry rule)
 // ============================================================================
 
 // Maps each hex ID to its vertical mirror across center column (col 2)
-// (from JavaScript lines 68-88)
-constexpr int VERTICAL_MIRROR_PAIRS[NUM_HEXES] = {
-    0,   // Hex 0 → 0 (center column)
-    2,   // Hex 1 → 2
-    1,   // Hex 2 → 1
-    5,   // Hex 3 → 5
-    4,   // Hex 4 → 4 (center column)
-    3,   // Hex 5 → 3
-    7,   // Hex 6 → 7
-    6,   // Hex 7 → 6
-    10,  // Hex 8 → 10
-    9,   // Hex 9 → 9 (center column)
-    8,   // Hex 10 → 8
-    12,  // Hex 11 → 12
-    11,  // Hex 12 → 11
-    15,  // Hex 13 → 15
-    14,  // Hex 14 → 14 (center column)
-    13,  // Hex 15 → 13
-    17,  // Hex 16 → 17
-    16,  // Hex 17 → 16
-    18   // Hex 18 → 18 (center column)
-};
+// (JavaScript lines 68-88)
+constexpr std::array<int, NUM_HEXES> VERTICAL_MIRROR_PAIRS = BoardGeometry::VERTICAL_MIRROR_PAIRS;
 
 // Center column hexes (mirror to themselves)
-constexpr int CENTER_COLUMN_HEXES[5] = {0, 4, 9, 14, 18};
+constexpr uint32_t CENTER_COLUMN_MASK = BoardGeometry::CENTER_COLUMN_MASK;
+
+constexpr std::array<int, BoardGeometry::MAX_CHAIN_LENGTH> calculateCenterColumnHexes() {
+    std::array<int, BoardGeometry::MAX_CHAIN_LENGTH> hexes{};
+    int count = 0;
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (VERTICAL_MIRROR_PAIRS[hexId] == hexId) hexes[count++] = hexId;
+    }
+    return hexes;
+}
+
+constexpr std::array<int, BoardGeometry::MAX_CHAIN_LENGTH> CENTER_COLUMN_HEXES = calculateCenterColumnHexes();
+
+// Bits of a hex and its mirror (one bit for center column hexes)
+constexpr uint32_t mirrorPairMask(int hexId) {
+    return (1u << hexId) | (1u << VERTICAL_MIRROR_PAIRS[hexId]);
+}
 
 // ============================================================================
 // SCORING CHAINS (diagonal lines)
 // ============================================================================
 
-// Player 1 chains: down-right diagonals (\)
-// (from JavaScript lines 92-98)
-constexpr int P1_CHAIN_COUNT = 5;
-constexpr int P1_CHAINS[P1_CHAIN_COUNT][5] = {
-    {0, 2, 5, -1, -1},        // 3-hex chain (padded with -1)
-    {1, 4, 7, 10, -1},        // 4-hex chain
-    {3, 6, 9, 12, 15},        // 5-hex chain (center diagonal)
-    {8, 11, 14, 17, -1},      // 4-hex chain
-    {13, 16, 18, -1, -1}      // 3-hex chain
-};
+// Player 1 chains: down-right diagonals (\), padded with -1 (JavaScript lines 92-98)
+// Player 2 chains: down-left diagonals (/) (JavaScript lines 101-107)
+constexpr int P1_CHAIN_COUNT = BoardGeometry::CHAINS_PER_PLAYER;
+constexpr int P2_CHAIN_COUNT = BoardGeometry::CHAINS_PER_PLAYER;
+constexpr int CHAINS_PER_PLAYER = BoardGeometry::CHAINS_PER_PLAYER;
 
-// Chain lengths for P1
-constexpr int P1_CHAIN_LENGTHS[P1_CHAIN_COUNT] = {3, 4, 5, 4, 3};
+constexpr std::array<std::array<int, BoardGeometry::MAX_CHAIN_LENGTH>, CHAINS_PER_PLAYER> P1_CHAINS = BoardGeometry::P1_CHAINS;
+constexpr std::array<std::array<int, BoardGeometry::MAX_CHAIN_LENGTH>, CHAINS_PER_PLAYER> P2_CHAINS = BoardGeometry::P2_CHAINS;
+constexpr std::array<int, CHAINS_PER_PLAYER> P1_CHAIN_LENGTHS = BoardGeometry::P1_CHAIN_LENGTHS;  // {3, 4, 5, 4, 3}
+constexpr std::array<int, CHAINS_PER_PLAYER> P2_CHAIN_LENGTHS = BoardGeometry::P2_CHAIN_LENGTHS;
 
-// Player 2 chains: down-left diagonals (/)
-// (from JavaScript lines 101-107)
-constexpr int P2_CHAIN_COUNT = 5;
-constexpr int P2_CHAINS[P2_CHAIN_COUNT][5] = {
-    {0, 1, 3, -1, -1},        // 3-hex chain
-    {2, 4, 6, 8, -1},         // 4-hex chain
-    {5, 7, 9, 11, 13},        // 5-hex chain (center diagonal)
-    {10, 12, 14, 16, -1},     // 4-hex chain
-    {15, 17, 18, -1, -1}      // 3-hex chain
-};
+// HEX_SCORING_CHAINS[hexId][player - 1] = index of the player's chain through a hex
+// (every hex lies on exactly one chain of each player)
+constexpr std::array<std::array<int8_t, 2>, NUM_HEXES> calculateHexScoringChains() {
+    std::array<std::array<int8_t, 2>, NUM_HEXES> chains{};
+    for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+        for (int i = 0; i < P1_CHAIN_LENGTHS[c]; i++) chains[P1_CHAINS[c][i]][0] = static_cast<int8_t>(c);
+        for (int i = 0; i < P2_CHAIN_LENGTHS[c]; i++) chains[P2_CHAINS[c][i]][1] = static_cast<int8_t>(c);
+    }
+    return chains;
+}
+
+constexpr std::array<std::array<int8_t, 2>, NUM_HEXES> HEX_SCORING_CHAINS = calculateHexScoringChains();
 
-// Chain lengths for P2
-constexpr int P2_CHAIN_LENGTHS[P2_CHAIN_COUNT] = {3, 4, 5, 4, 3};
+// SCORING_CHAIN_MASKS[player - 1][chain] = bits of the hexes on a chain
+constexpr std::array<std::array<uint32_t, CHAINS_PER_PLAYER>, 2> calculateScoringChainMasks() {
+    std::array<std::array<uint32_t, CHAINS_PER_PLAYER>, 2> masks{};
+    for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+        for (int i = 0; i < P1_CHAIN_LENGTHS[c]; i++) masks[0][c] |= 1u << P1_CHAINS[c][i];
+        for (int i = 0; i < P2_CHAIN_LENGTHS[c]; i++) masks[1][c] |= 1u << P2_CHAINS[c][i];
+    }
+    return masks;
+}
+
+constexpr std::array<std::array<uint32_t, CHAINS_PER_PLAYER>, 2> SCORING_CHAIN_MASKS = calculateScoringChainMasks();
 
 // ============================================================================
 // CHAIN LENGTH CONSTRAINT
 // ============================================================================
 
 // Chain starters for detecting continuous occupied chains in any direction
-// (from JavaScript lines 180-196)
-struct ChainStarter {
-    int startHex;
-    Direction dir;
-};
-
-constexpr ChainStarter CHAIN_STARTERS[15] = {
-    {0,  {1, -1}},  // DOWNLEFT
-    {0,  {2,  0}},  // DOWN
-    {0,  {1,  1}},  // DOWNRIGHT
-    {1,  {2,  0}},  // DOWN
-    {1,  {1,  1}},  // DOWNRIGHT
-    {2,  {1, -1}},  // DOWNLEFT
-    {2,  {2,  0}},  // DOWN
-    {3,  {2,  0}},  // DOWN
-    {3,  {1,  1}},  // DOWNRIGHT
-    {5,  {1, -1}},  // DOWNLEFT
-    {5,  {2,  0}},  // DOWN
-    {8,  {1,  1}},  // DOWNRIGHT
-    {10, {1, -1}},  // DOWNLEFT
-    {13, {1,  1}},  // DOWNRIGHT
-    {15, {1, -1}}   // DOWNLEFT
-};
+// (JavaScript lines 180-196): by hex ID, then DOWNLEFT, DOWN, DOWNRIGHT
+constexpr std::array<ChainStarter, BoardGeometry::NUM_LINES> CHAIN_STARTERS = BoardGeometry::CHAIN_STARTERS;
+
+// ============================================================================
+// PRECOMPUTED HEX GEOMETRY (built at compile time from the tables above)
+// ============================================================================
+
+constexpr int NUM_LINES = BoardGeometry::NUM_LINES;               // One line per CHAIN_STARTERS entry
+constexpr int MAX_LINE_LENGTH = BoardGeometry::MAX_CHAIN_LENGTH;  // Longest line (center column / diagonals)
+constexpr int LINES_PER_HEX = 3;     // Every hex lies on exactly one line per axis
+
+// Bitmask with all 19 hexes set (board full)
+constexpr uint32_t ALL_HEXES_MASK = (1u << NUM_HEXES) - 1;
+
+// Find hex at row/col (-1 if off the board)
+constexpr int findHexAt(int row, int col) {
+    for (int i = 0; i < NUM_HEXES; i++) {
+        if (HEX_POSITIONS[i].row == row && HEX_POSITIONS[i].col == col) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Index of a row/col offset in HEX_DIRECTIONS (-1 if not a hex direction)
+constexpr int findDirectionIndex(const Direction& dir) {
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (HEX_DIRECTIONS[d].dr == dir.dr && HEX_DIRECTIONS[d].dc == dir.dc) {
+            return d;
+        }
+    }
+    return -1;
+}
+
+// NEXT_HEX[hexId][dir] = neighbouring hex in HEX_DIRECTIONS[dir], or -1 off-board
+constexpr std::array<std::array<int8_t, NUM_DIRECTIONS>, NUM_HEXES> calculateNextHex() {
+    std::array<std::array<int8_t, NUM_DIRECTIONS>, NUM_HEXES> next{};
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            next[hexId][d] = static_cast<int8_t>(findHexAt(HEX_POSITIONS[hexId].row + HEX_DIRECTIONS[d].dr,
+                                                           HEX_POSITIONS[hexId].col + HEX_DIRECTIONS[d].dc));
+        }
+    }
+    return next;
+}
+
+constexpr std::array<std::array<int8_t, NUM_DIRECTIONS>, NUM_HEXES> NEXT_HEX = calculateNextHex();
+
+// HEX_NEIGHBOR_MASKS[hexId] = 19-bit mask of the (up to 6) adjacent hexes
+constexpr std::array<uint32_t, NUM_HEXES> calculateNeighborMasks() {
+    std::array<uint32_t, NUM_HEXES> masks{};
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            if (NEXT_HEX[hexId][d] >= 0) {
+                masks[hexId] |= (1u << NEXT_HEX[hexId][d]);
+            }
+        }
+    }
+    return masks;
+}
+
+constexpr std::array<uint32_t, NUM_HEXES> HEX_NEIGHBOR_MASKS = calculateNeighborMasks();
+
+// LINE_HEXES[line] = hexes along CHAIN_STARTERS[line] in walk order (padded with -1)
+constexpr std::array<std::array<int8_t, MAX_LINE_LENGTH>, NUM_LINES> calculateLineHexes() {
+    std::array<std::array<int8_t, MAX_LINE_LENGTH>, NUM_LINES> lines{};
+    for (int line = 0; line < NUM_LINES; line++) {
+        int dir = findDirectionIndex(CHAIN_STARTERS[line].dir);
+        int hexId = CHAIN_STARTERS[line].startHex;
+        for (int i = 0; i < MAX_LINE_LENGTH; i++) {
+            lines[line][i] = static_cast<int8_t>(hexId);
+            if (hexId >= 0) hexId = NEXT_HEX[hexId][dir];
+        }
+    }
+    return lines;
+}
+
+constexpr std::array<std::array<int8_t, MAX_LINE_LENGTH>, NUM_LINES> LINE_HEXES = calculateLineHexes();
+
+constexpr std::array<int, NUM_LINES> calculateLineLengths() {
+    std::array<int, NUM_LINES> lengths{};
+    for (int line = 0; line < NUM_LINES; line++) {
+        while (lengths[line] < MAX_LINE_LENGTH && LINE_HEXES[line][lengths[line]] >= 0) {
+            lengths[line]++;
+        }
+    }
+    return lengths;
+}
+
+constexpr std::array<int, NUM_LINES> LINE_LENGTHS = calculateLineLengths();
+
+// LINE_MASKS[line] = 19-bit membership mask of each line
+constexpr std::array<uint32_t, NUM_LINES> calculateLineMasks() {
+    std::array<uint32_t, NUM_LINES> masks{};
+    for (int line = 0; line < NUM_LINES; line++) {
+        for (int i = 0; i < LINE_LENGTHS[line]; i++) {
+            masks[line] |= (1u << LINE_HEXES[line][i]);
+        }
+    }
+    return masks;
+}
+
+constexpr std::array<uint32_t, NUM_LINES> LINE_MASKS = calculateLineMasks();
+
+// Lines are grouped by axis (direction of travel); each axis has 5 parallel lines.
+// LINE_AXIS[line] = axis index (order of first appearance in CHAIN_STARTERS)
+// LINE_SLOT[line] = index of the line among the lines of its axis
+constexpr int LINES_PER_AXIS = NUM_LINES / LINES_PER_HEX;
+
+constexpr std::array<int8_t, NUM_LINES> calculateLineAxes(bool slots) {
+    std::array<int8_t, NUM_LINES> result{};
+    int axisDirection[LINES_PER_HEX] = {-1, -1, -1};
+    int axisCount[LINES_PER_HEX] = {};
+    for (int line = 0; line < NUM_LINES; line++) {
+        int dir = findDirectionIndex(CHAIN_STARTERS[line].dir);
+        int axis = 0;
+        while (axisDirection[axis] != -1 && axisDirection[axis] != dir) axis++;
+        axisDirection[axis] = dir;
+        result[line] = static_cast<int8_t>(slots ? axisCount[axis]++ : axis);
+    }
+    return result;
+}
+
+constexpr std::array<int8_t, NUM_LINES> LINE_AXIS = calculateLineAxes(false);
+constexpr std::array<int8_t, NUM_LINES> LINE_SLOT = calculateLineAxes(true);
+
+// HEX_LINES[hexId][axis] = the line through a hex along each axis
+// HEX_LINE_POSITIONS[hexId][axis] = index of the hex within that line
+constexpr std::array<std::array<int8_t, LINES_PER_HEX>, NUM_HEXES> calculateHexLines(bool positions) {
+    std::array<std::array<int8_t, LINES_PER_HEX>, NUM_HEXES> result{};
+    for (int line = 0; line < NUM_LINES; line++) {
+        for (int i = 0; i < LINE_LENGTHS[line]; i++) {
+            result[LINE_HEXES[line][i]][LINE_AXIS[line]] = static_cast<int8_t>(positions ? i : line);
+        }
+    }
+    return result;
+}
+
+constexpr std::array<std::array<int8_t, LINES_PER_HEX>, NUM_HEXES> HEX_LINES = calculateHexLines(false);
+constexpr std::array<std::array<int8_t, LINES_PER_HEX>, NUM_HEXES> HEX_LINE_POSITIONS = calculateHexLines(true);
+
+// ============================================================================
+// LINE RUN TABLES (for the chain length constraint)
+// ============================================================================
+
+// A line's occupancy is a 5-bit pattern (bit i = i-th hex along the line).
+// The board keeps the patterns of each axis packed into one uint32_t
+// (5 bits per line) and a histogram of all run lengths on the board.
+
+constexpr int LINE_PATTERN_BITS = MAX_LINE_LENGTH;
+constexpr int NUM_LINE_PATTERNS = 1 << LINE_PATTERN_BITS;
+constexpr uint32_t LINE_PATTERN_MASK = NUM_LINE_PATTERNS - 1;
+
+// Run histogram packing: 6 bits per run length 1-5 (at most 57 runs of a length)
+constexpr int RUN_COUNT_BITS = 6;
+constexpr uint32_t RUN_COUNT_MASK = (1u << RUN_COUNT_BITS) - 1;
+
+constexpr uint32_t runHistogramField(int length) {
+    return 1u << ((length - 1) * RUN_COUNT_BITS);
+}
+
+// LINE_RUN_HISTOGRAM[pattern] = packed count of runs per length in a pattern
+constexpr std::array<uint32_t, NUM_LINE_PATTERNS> calculateLineRunHistograms() {
+    std::array<uint32_t, NUM_LINE_PATTERNS> histograms{};
+    for (int pattern = 0; pattern < NUM_LINE_PATTERNS; pattern++) {
+        int run = 0;
+        for (int i = 0; i <= LINE_PATTERN_BITS; i++) {
+            if (i < LINE_PATTERN_BITS && (pattern & (1 << i))) {
+                run++;
+            } else if (run > 0) {
+                histograms[pattern] += runHistogramField(run);
+                run = 0;
+            }
+        }
+    }
+    return histograms;
+}
+
+constexpr std::array<uint32_t, NUM_LINE_PATTERNS> LINE_RUN_HISTOGRAM = calculateLineRunHistograms();
+
+// LINE_RUN_THROUGH[pattern][i] = length of the run covering position i (0 if empty)
+constexpr std::array<std::array<uint8_t, LINE_PATTERN_BITS>, NUM_LINE_PATTERNS> calculateLineRunThrough() {
+    std::array<std::array<uint8_t, LINE_PATTERN_BITS>, NUM_LINE_PATTERNS> through{};
+    for (int pattern = 0; pattern < NUM_LINE_PATTERNS; pattern++) {
+        for (int i = 0; i < LINE_PATTERN_BITS; i++) {
+            if (!(pattern & (1 << i))) continue;
+            int lo = i, hi = i;
+            while (lo > 0 && (pattern & (1 << (lo - 1)))) lo--;
+            while (hi < LINE_PATTERN_BITS - 1 && (pattern & (1 << (hi + 1)))) hi++;
+            through[pattern][i] = static_cast<uint8_t>(hi - lo + 1);
+        }
+    }
+    return through;
+}
+
+constexpr std::array<std::array<uint8_t, LINE_PATTERN_BITS>, NUM_LINE_PATTERNS> LINE_RUN_THROUGH = calculateLineRunThrough();
+
+// Second longest run on the board (runs sorted descending, element [1])
+constexpr int secondLongestRun(uint32_t runHistogram) {
+    int found = 0;
+    for (int length = MAX_LINE_LENGTH; length >= 1; length--) {
+        found += (runHistogram >> ((length - 1) * RUN_COUNT_BITS)) & RUN_COUNT_MASK;
+        if (found >= 2) return length;
+    }
+    return 0;
+}
+
+// ============================================================================
+// BOARD SYMMETRIES (canonical hashing)
+// ============================================================================
+
+// The vertical mirror swaps the P1 (down-right) and P2 (down-left) chain
+// axes, so a mirrored position is equivalent only with the players swapped.
+// The 180 degree rotation keeps both axes. Together they form the symmetry
+// group used for canonical keys (every element is its own inverse):
+//   0 = identity, 1 = vertical mirror + swap, 2 = 180 rotation,
+//   3 = horizontal mirror + swap (mirror of the rotation)
+constexpr int NUM_SYMMETRIES = 4;
+constexpr bool SYMMETRY_SWAPS_PLAYERS[NUM_SYMMETRIES] = {false, true, false, true};
+
+constexpr std::array<std::array<int8_t, NUM_HEXES>, NUM_SYMMETRIES> calculateSymmetryHexMap() {
+    std::array<std::array<int8_t, NUM_HEXES>, NUM_SYMMETRIES> map{};
+    for (int h = 0; h < NUM_HEXES; h++) {
+        int rotated = BoardGeometry::ROTATED_HEXES[h];
+        map[0][h] = static_cast<int8_t>(h);
+        map[1][h] = static_cast<int8_t>(VERTICAL_MIRROR_PAIRS[h]);
+        map[2][h] = static_cast<int8_t>(rotated);
+        map[3][h] = static_cast<int8_t>(VERTICAL_MIRROR_PAIRS[rotated]);
+    }
+    return map;
+}
+
+constexpr std::array<std::array<int8_t, NUM_HEXES>, NUM_SYMMETRIES> SYMMETRY_HEX_MAP = calculateSymmetryHexMap();
+
+// Player who plays the role of 'player' in the transformed position
+constexpr int symmetricPlayer(int symmetry, int player) {
+    return SYMMETRY_SWAPS_PLAYERS[symmetry] ? (PLAYER_1 + PLAYER_2 - player) : player;
+}
+
+// Sanity checks: the generated tables match the JavaScript engine's
+static_assert(HEX_POSITIONS[CENTER_HEX].row == 4 && HEX_POSITIONS[CENTER_HEX].col == 2 &&
+              HEX_POSITIONS[18].row == 8, "Hex IDs must run row by row from the top hex");
+static_assert(VERTICAL_MIRROR_PAIRS[1] == 2 && VERTICAL_MIRROR_PAIRS[8] == 10 && VERTICAL_MIRROR_PAIRS[14] == 14,
+              "Mirror pairs must reflect across the center column");
+static_assert(P1_CHAINS[0][2] == 5 && P1_CHAINS[0][3] == -1 && P1_CHAINS[2][0] == 3 && P1_CHAINS[2][4] == 15 &&
+              P1_CHAINS[4][0] == 13, "P1 chains must be {0,2,5}, {1,4,7,10}, {3,6,9,12,15}, ...");
+static_assert(P2_CHAINS[1][0] == 2 && P2_CHAINS[1][3] == 8 && P2_CHAINS[2][4] == 13 && P2_CHAINS[4][2] == 18,
+              "P2 chains must be {0,1,3}, {2,4,6,8}, {5,7,9,11,13}, ...");
+static_assert(P1_CHAIN_LENGTHS[0] == 3 && P1_CHAIN_LENGTHS[2] == 5 && P2_CHAIN_LENGTHS[4] == 3,
+              "Chains must be 3, 4, 5, 4, 3 hexes long");
+static_assert(CHAIN_STARTERS[3].startHex == 1 && CHAIN_STARTERS[3].dir.dr == 2 &&
+              CHAIN_STARTERS[11].startHex == 8 && CHAIN_STARTERS[14].startHex == 15 && CHAIN_STARTERS[14].dir.dc == -1,
+              "Chain starters must match the JavaScript table");
+static_assert(CENTER_COLUMN_MASK == ((1u << 0) | (1u << 4) | (1u << 9) | (1u << 14) | (1u << 18)),
+              "Center column must be hexes 0, 4, 9, 14, 18");
+
+// The 15 rays cover every hex exactly three times
+static_assert(LINE_MASKS[0] == ((1u << 0) | (1u << 1) | (1u << 3)), "Line 0 must be hexes 0,1,3");
+static_assert(HEX_NEIGHBOR_MASKS[CENTER_HEX] == ((1u << 4) | (1u << 6) | (1u << 7) |
+                                                 (1u << 11) | (1u << 12) | (1u << 14)),
+              "Center hex must have 6 neighbours");
+static_assert(LINE_SLOT[NUM_LINES - 1] == LINES_PER_AXIS - 1, "Each axis must have 5 lines");
+static_assert(SYMMETRY_HEX_MAP[2][0] == 18 && SYMMETRY_HEX_MAP[2][CENTER_HEX] == CENTER_HEX,
+              "180 degree rotation maps the top hex to the bottom and fixes the center");
+static_assert(SYMMETRY_HEX_MAP[2][P1_CHAINS[0][0]] == P1_CHAINS[P1_CHAIN_COUNT - 1][2],
+              "Rotation must keep P1 chains P1 chains");
+static_assert(LINE_RUN_HISTOGRAM[0b10111] == runHistogramField(1) + runHistogramField(3),
+              "Pattern 10111 has runs of length 3 and 1");
 
 } // namespace hexuki
 
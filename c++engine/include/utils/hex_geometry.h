@@ -0,0 +1,267 @@
+#ifndef HEXUKI_HEX_GEOMETRY_H
+#define HEXUKI_HEX_GEOMETRY_H
+
+#include <cstdint>
+#include <array>
+#include <type_traits>
+
+namespace hexuki {
+
+// ============================================================================
+// HEX GRID COORDINATES
+// ============================================================================
+
+// Hexes sit on a doubled-row grid: moving straight down is two rows, moving
+// diagonally is one row and one column. IDs run row by row, left to right.
+struct HexPosition {
+    int id;
+    int row;
+    int col;
+};
+
+struct Direction {
+    int dr;  // Row offset
+    int dc;  // Column offset
+};
+
+constexpr int NUM_DIRECTIONS = 6;
+
+// 6 hex directions (from JavaScript lines 117-124)
+constexpr Direction HEX_DIRECTIONS[NUM_DIRECTIONS] = {
+    {-2,  0},  // UP
+    {-1,  1},  // UPRIGHT
+    { 1,  1},  // DOWNRIGHT
+    { 2,  0},  // DOWN
+    { 1, -1},  // DOWNLEFT
+    {-1, -1}   // UPLEFT
+};
+
+constexpr Direction DIR_DOWNRIGHT = HEX_DIRECTIONS[2];  // P1 chains
+constexpr Direction DIR_DOWN = HEX_DIRECTIONS[3];
+constexpr Direction DIR_DOWNLEFT = HEX_DIRECTIONS[4];   // P2 chains
+
+// A line (for the chain length constraint): first hex and direction of travel
+struct ChainStarter {
+    int startHex;
+    Direction dir;
+};
+
+// Number of hexes on a hexagonal board with 'radius' rings around the center
+constexpr int hexCount(int radius) {
+    return 3 * radius * (radius + 1) + 1;
+}
+
+namespace geometry_detail {
+
+constexpr int absInt(int x) { return x < 0 ? -x : x; }
+
+// Is (row, col) a hex of the radius-R board? (hex distance from the center <= R)
+constexpr bool onBoard(int radius, int row, int col) {
+    if (row < 0 || row > 4 * radius || col < 0 || col > 2 * radius) return false;
+    if ((row + col) % 2 != radius % 2) return false;
+    int dr = absInt(row - 2 * radius);
+    int dc = absInt(col - radius);
+    return dc + (dr > dc ? (dr - dc) / 2 : 0) <= radius;
+}
+
+template <int Radius>
+constexpr std::array<HexPosition, hexCount(Radius)> makePositions() {
+    std::array<HexPosition, hexCount(Radius)> positions{};
+    int id = 0;
+    for (int row = 0; row <= 4 * Radius; row++) {
+        for (int col = 0; col <= 2 * Radius; col++) {
+            if (onBoard(Radius, row, col)) {
+                positions[id] = HexPosition{id, row, col};
+                id++;
+            }
+        }
+    }
+    return positions;
+}
+
+template <int Radius>
+constexpr int findHexAt(const std::array<HexPosition, hexCount(Radius)>& positions, int row, int col) {
+    for (int i = 0; i < hexCount(Radius); i++) {
+        if (positions[i].row == row && positions[i].col == col) return i;
+    }
+    return -1;
+}
+
+// Each hex's image under a reflection of the column and/or row
+template <int Radius>
+constexpr std::array<int, hexCount(Radius)> makeReflection(bool flipRows, bool flipCols) {
+    constexpr auto positions = makePositions<Radius>();
+    std::array<int, hexCount(Radius)> image{};
+    for (int h = 0; h < hexCount(Radius); h++) {
+        int row = flipRows ? 4 * Radius - positions[h].row : positions[h].row;
+        int col = flipCols ? 2 * Radius - positions[h].col : positions[h].col;
+        image[h] = findHexAt<Radius>(positions, row, col);
+    }
+    return image;
+}
+
+// Lines along dir, one per hex with no predecessor in that direction (ID order)
+template <int Radius>
+constexpr std::array<std::array<int, 2 * Radius + 1>, 2 * Radius + 1> makeChains(Direction dir) {
+    constexpr auto positions = makePositions<Radius>();
+    std::array<std::array<int, 2 * Radius + 1>, 2 * Radius + 1> chains{};
+    int chain = 0;
+    for (int h = 0; h < hexCount(Radius); h++) {
+        if (findHexAt<Radius>(positions, positions[h].row - dir.dr, positions[h].col - dir.dc) >= 0) continue;
+        int hexId = h;
+        for (int i = 0; i < 2 * Radius + 1; i++) {
+            chains[chain][i] = hexId;
+            if (hexId >= 0) {
+                hexId = findHexAt<Radius>(positions, positions[hexId].row + dir.dr, positions[hexId].col + dir.dc);
+            }
+        }
+        chain++;
+    }
+    return chains;
+}
+
+template <int Radius>
+constexpr std::array<int, 2 * Radius + 1> makeChainLengths(Direction dir) {
+    constexpr int maxLength = 2 * Radius + 1;
+    auto chains = makeChains<Radius>(dir);
+    std::array<int, maxLength> lengths{};
+    for (int c = 0; c < maxLength; c++) {
+        while (lengths[c] < maxLength && chains[c][lengths[c]] >= 0) lengths[c]++;
+    }
+    return lengths;
+}
+
+// Line starters: for each hex in ID order, every axis (DOWNLEFT, DOWN,
+// DOWNRIGHT) along which it has no predecessor
+template <int Radius>
+constexpr std::array<ChainStarter, 3 * (2 * Radius + 1)> makeChainStarters() {
+    constexpr auto positions = makePositions<Radius>();
+    constexpr Direction axes[3] = {DIR_DOWNLEFT, DIR_DOWN, DIR_DOWNRIGHT};
+    std::array<ChainStarter, 3 * (2 * Radius + 1)> starters{};
+    int line = 0;
+    for (int h = 0; h < hexCount(Radius); h++) {
+        for (const Direction& dir : axes) {
+            if (findHexAt<Radius>(positions, positions[h].row - dir.dr, positions[h].col - dir.dc) < 0) {
+                starters[line++] = ChainStarter{h, dir};
+            }
+        }
+    }
+    return starters;
+}
+
+// Axis of a line direction: 0 = DOWNLEFT, 1 = DOWN, 2 = DOWNRIGHT
+constexpr int lineAxis(Direction dir) {
+    return dir.dc + 1;
+}
+
+// [hexId][axis] = line through a hex along each axis (CHAIN_STARTERS index),
+// or with positions = true, the hex's index along that line
+template <int Radius>
+constexpr std::array<std::array<int, 3>, hexCount(Radius)> makeHexLines(bool positions) {
+    constexpr auto hexes = makePositions<Radius>();
+    constexpr auto starters = makeChainStarters<Radius>();
+    std::array<std::array<int, 3>, hexCount(Radius)> result{};
+    for (int line = 0; line < 3 * (2 * Radius + 1); line++) {
+        Direction dir = starters[line].dir;
+        int index = 0;
+        for (int h = starters[line].startHex; h >= 0;
+             h = findHexAt<Radius>(hexes, hexes[h].row + dir.dr, hexes[h].col + dir.dc)) {
+            result[h][lineAxis(dir)] = positions ? index : line;
+            index++;
+        }
+    }
+    return result;
+}
+
+// [hexId][player - 1] = index of the player's scoring chain through a hex
+template <int Radius>
+constexpr std::array<std::array<int, 2>, hexCount(Radius)> makeHexChains() {
+    constexpr auto p1Chains = makeChains<Radius>(DIR_DOWNRIGHT);
+    constexpr auto p2Chains = makeChains<Radius>(DIR_DOWNLEFT);
+    std::array<std::array<int, 2>, hexCount(Radius)> result{};
+    for (int c = 0; c < 2 * Radius + 1; c++) {
+        for (int i = 0; i < 2 * Radius + 1; i++) {
+            if (p1Chains[c][i] >= 0) result[p1Chains[c][i]][0] = c;
+            if (p2Chains[c][i] >= 0) result[p2Chains[c][i]][1] = c;
+        }
+    }
+    return result;
+}
+
+template <int Radius, typename Mask>
+constexpr std::array<Mask, hexCount(Radius)> makeNeighborMasks() {
+    constexpr auto positions = makePositions<Radius>();
+    std::array<Mask, hexCount(Radius)> masks{};
+    for (int h = 0; h < hexCount(Radius); h++) {
+        for (const Direction& dir : HEX_DIRECTIONS) {
+            int next = findHexAt<Radius>(positions, positions[h].row + dir.dr, positions[h].col + dir.dc);
+            if (next >= 0) masks[h] |= Mask(1) << next;
+        }
+    }
+    return masks;
+}
+
+template <int Radius, typename Mask>
+constexpr Mask makeCenterColumnMask() {
+    constexpr auto positions = makePositions<Radius>();
+    Mask mask = 0;
+    for (int h = 0; h < hexCount(Radius); h++) {
+        if (positions[h].col == Radius) mask |= Mask(1) << h;
+    }
+    return mask;
+}
+
+} // namespace geometry_detail
+
+/**
+ * Board geometry generated from the board radius
+ *
+ * Radius 2 is the standard 19-hex board (utils/constants.h aliases these
+ * tables); radius 3 and 4 give the 37- and 61-hex community boards. Every
+ * table is built at compile time from the coordinate rules:
+ * - Hexes: doubled-row grid within hex distance Radius of the center
+ * - Chains: P1 scores the DOWNRIGHT lines, P2 the DOWNLEFT lines
+ * - Lines (chain length rule): DOWNLEFT, DOWN and DOWNRIGHT lines, one
+ *   through every hex per axis
+ * - Mirror: column reflection; rotation: 180 degrees about the center
+ *
+ * Masks are uint32_t up to 32 hexes and uint64_t above.
+ */
+template <int Radius>
+struct HexGeometry {
+    static_assert(Radius >= 1 && hexCount(Radius) <= 64, "Board must fit in a 64-bit mask");
+
+    static constexpr int RADIUS = Radius;
+    static constexpr int NUM_HEXES = hexCount(Radius);
+    static constexpr int CENTER_HEX = NUM_HEXES / 2;           // IDs are symmetric about the center
+    static constexpr int CHAINS_PER_PLAYER = 2 * Radius + 1;  // Also lines per axis
+    static constexpr int MAX_CHAIN_LENGTH = 2 * Radius + 1;
+    static constexpr int NUM_LINES = 3 * CHAINS_PER_PLAYER;
+
+    using Mask = std::conditional_t<(NUM_HEXES <= 32), uint32_t, uint64_t>;
+    static constexpr Mask ALL_HEXES_MASK = NUM_HEXES == 64 ? ~Mask(0) : (Mask(1) << NUM_HEXES) - 1;
+
+    static constexpr std::array<HexPosition, NUM_HEXES> HEX_POSITIONS = geometry_detail::makePositions<Radius>();
+    static constexpr std::array<int, NUM_HEXES> VERTICAL_MIRROR_PAIRS = geometry_detail::makeReflection<Radius>(false, true);
+    static constexpr std::array<int, NUM_HEXES> ROTATED_HEXES = geometry_detail::makeReflection<Radius>(true, true);
+    static constexpr Mask CENTER_COLUMN_MASK = geometry_detail::makeCenterColumnMask<Radius, Mask>();
+
+    static constexpr auto P1_CHAINS = geometry_detail::makeChains<Radius>(DIR_DOWNRIGHT);  // Padded with -1
+    static constexpr auto P2_CHAINS = geometry_detail::makeChains<Radius>(DIR_DOWNLEFT);
+    static constexpr auto P1_CHAIN_LENGTHS = geometry_detail::makeChainLengths<Radius>(DIR_DOWNRIGHT);
+    static constexpr auto P2_CHAIN_LENGTHS = geometry_detail::makeChainLengths<Radius>(DIR_DOWNLEFT);
+
+    static constexpr std::array<ChainStarter, NUM_LINES> CHAIN_STARTERS = geometry_detail::makeChainStarters<Radius>();
+    static constexpr auto HEX_CHAINS = geometry_detail::makeHexChains<Radius>();          // [hexId][player - 1]
+    static constexpr auto HEX_LINES = geometry_detail::makeHexLines<Radius>(false);       // [hexId][axis]
+    static constexpr auto HEX_LINE_POSITIONS = geometry_detail::makeHexLines<Radius>(true);
+    static constexpr std::array<Mask, NUM_HEXES> NEIGHBOR_MASKS = geometry_detail::makeNeighborMasks<Radius, Mask>();
+
+    static constexpr int findHexAt(int row, int col) {
+        return geometry_detail::findHexAt<Radius>(HEX_POSITIONS, row, col);
+    }
+};
+
+} // namespace hexuki
+
+#endif // HEXUKI_HEX_GEOMETRY_H
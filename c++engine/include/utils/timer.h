@@ -3,6 +3,10 @@
 
 #include <cstdint>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace hexuki {
 
 /**
@@ -24,6 +28,17 @@ public:
 #endif
     }
 
+    // Count trailing zeros (64-bit)
+    static inline int countTrailingZeros64(uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
     // Count set bits (population count)
     static inline int popcount(uint32_t value) {
 #ifdef _MSC_VER
@@ -34,6 +49,26 @@ public:
         return __builtin_popcount(value);
 #endif
     }
+
+    // Count set bits (64-bit)
+    static inline int popcount64(uint64_t value) {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(value));
+#else
+        return __builtin_popcountll(value);
+#endif
+    }
+
+    // Position of the n-th lowest set bit (n counts from 0, must be < popcount)
+    static inline int selectBit(uint32_t value, int n) {
+        for (; n > 0; n--) value &= value - 1;
+        return countTrailingZeros(value);
+    }
+
+    static inline int selectBit64(uint64_t value, int n) {
+        for (; n > 0; n--) value &= value - 1;
+        return countTrailingZeros64(value);
+    }
 };
 
 } // namespace hexuki
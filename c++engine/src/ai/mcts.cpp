@@ -7,6 +7,10 @@
 namespace hexuki {
 namespace mcts {
 
+// Rollouts check ScoreBounds for a decided winner only with this many empty
+// hexes or fewer (earlier ones almost never are)
+constexpr int DECIDED_ROLLOUT_EMPTIES = 3;
+
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
@@ -49,7 +53,7 @@ MCTSResult MCTS::findBestMove(HexukiBitboard& board, const MCTSConfig& config) {
     resetTree();
     root = new MCTSNode();
     root->playerToMove = rootPlayer;  // Root player makes the first move
-    root->untriedMoves = board.getValidMoves();
+    board.generateMoves(root->untriedMoves);
 
     // Clear shared transposition table for fresh search
     // (cache will build up during simulations and speed up later ones)
@@ -88,12 +92,18 @@ MCTSResult MCTS::findBestMove(HexukiBitboard& board, const MCTSConfig& config) {
         }
 
         // 3. SIMULATION: Play random game to end (or use minimax for endgame)
-        double score = simulate(simBoard, config);
-
         // 4. BACKPROPAGATION: Update all ancestors
-        backpropagate(node, score);
-
-        result.simulations++;
+        if (config.playoutsPerLeaf > 1 && !config.useMinimaxRollouts &&
+            simBoard.getRuleFlags() == DEFAULT_RULE_FLAGS) {
+            // K lockstep random playouts from this leaf in one batch
+            double score = simulateBatch(simBoard, config.playoutsPerLeaf);
+            backpropagate(node, score, config.playoutsPerLeaf);
+            result.simulations += config.playoutsPerLeaf;
+        } else {
+            double score = simulate(simBoard, config);
+            backpropagate(node, score);
+            result.simulations++;
+        }
 
         // Print progress
         if (config.verbose && result.simulations % 1000 == 0) {
@@ -203,8 +213,8 @@ MCTSNode* MCTS::expand(MCTSNode* node, HexukiBitboard& board) {
     size_t idx = dist(rng);
     Move move = node->untriedMoves[idx];
 
-    // Remove from untried moves
-    node->untriedMoves.erase(node->untriedMoves.begin() + idx);
+    // Remove from untried moves (order doesn't matter, picks are random)
+    node->untriedMoves.swapRemove(idx);
 
     // Make the move
     board.makeMove(move);
@@ -215,7 +225,7 @@ MCTSNode* MCTS::expand(MCTSNode* node, HexukiBitboard& board) {
 
     // Initialize child's untried moves
     if (!isTerminal(board)) {
-        child->untriedMoves = board.getValidMoves();
+        board.generateMoves(child->untriedMoves);
     }
 
     return child;
@@ -227,8 +237,25 @@ MCTSNode* MCTS::expand(MCTSNode* node, HexukiBitboard& board) {
  * Returns score from Player 1's perspective
  */
 double MCTS::simulate(HexukiBitboard& board, const MCTSConfig& config) {
+    // Pick the rollout specialized for this variant once per simulation
+    return dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        return simulateWith(board, config, rules);
+    });
+}
+
+template <typename R>
+double MCTS::simulateWith(HexukiBitboard& board, const MCTSConfig& config, R rules) {
     // Phase 1: Random rollout until threshold (if minimax enabled)
     while (!isTerminal(board)) {
+        // Winner already fixed by the reachable score ranges: the rest of the
+        // rollout can't change the result. Bounds rarely decide a game with
+        // more hexes open, so earlier plies skip the check.
+        if (config.stopDecidedRollouts &&
+            BitOps::popcount(board.getOccupiedMask()) >= NUM_HEXES - DECIDED_ROLLOUT_EMPTIES) {
+            int winner = board.getScoreBounds().decidedWinner();
+            if (winner != 0) return (winner == PLAYER_1) ? 1.0 : 0.0;
+        }
+
         // Check if we should switch to minimax evaluation
         if (config.useMinimaxRollouts) {
             int emptyHexes = 0;
@@ -240,48 +267,26 @@ double MCTS::simulate(HexukiBitboard& board, const MCTSConfig& config) {
 
             // Switch to minimax when at or below threshold
             if (emptyHexes <= config.minimaxThreshold) {
-                // Use minimax with SHARED transposition table for speed
-                // Cache builds up across simulations → later sims are much faster
-                int searchDepth = emptyHexes;
+                // Solve the endgame's outcome (WDL only, no exact margin) with a
+                // SHARED transposition table: later simulations reuse the cache
                 int currentPlayer = board.getCurrentPlayer();
-                int nodesSearched = 0;
-
-                // Call minimax alpha-beta with shared TT
-                int score = minimax::alphaBeta(
-                    board,
-                    searchDepth,
-                    -1000000,  // alpha
-                    1000000,   // beta
-                    *sharedMinimaxTT,  // SHARED TT across all simulations!
-                    nodesSearched,
-                    std::chrono::steady_clock::now(),
-                    30000  // timeout
-                );
-
-                // Minimax score is from CURRENT PLAYER's perspective
-                // Positive = current player wins, Negative = current player loses
-                // Zero = draw/timeout/uncertain
-
-                // Convert to P1 perspective (matching JavaScript logic)
-                // score > 0: current player wins
-                // score < 0: current player loses
-                // score == 0: uncertain/draw → return 0.5
-
-                if (score > 0) {
-                    // Current player wins
+                int64_t nodesSearched = 0;
+                minimax::Outcome outcome = minimax::solveOutcome(board, *sharedMinimaxTT, nodesSearched, 30000);
+
+                // Outcome is for the CURRENT PLAYER; convert to P1 perspective
+                // (timeout counts as uncertain → 0.5)
+                if (outcome == minimax::Outcome::WIN) {
                     return (currentPlayer == PLAYER_1) ? 1.0 : 0.0;
-                } else if (score < 0) {
-                    // Current player loses
+                } else if (outcome == minimax::Outcome::LOSS) {
                     return (currentPlayer == PLAYER_1) ? 0.0 : 1.0;
                 } else {
-                    // Draw/timeout/uncertain → 0.5
                     return 0.5;
                 }
             }
         }
 
-        // Continue random rollout
-        std::vector<Move> moves = board.getValidMoves();
+        // Continue random rollout (one random index, no move list)
+        MoveGenerator moves(board, rules);
         if (moves.empty()) break;
 
         Move move = selectRandomMove(moves);
@@ -292,6 +297,43 @@ double MCTS::simulate(HexukiBitboard& board, const MCTSConfig& config) {
     return evaluateTerminal(board);
 }
 
+/**
+ * BATCHED SIMULATION
+ * Play 'playouts' random games from the same leaf in SIMD lockstep
+ * (widest BoardBatch that fits, then 8-wide batches for the rest)
+ * Returns the sum of results from Player 1's perspective
+ */
+double MCTS::simulateBatch(const HexukiBitboard& board, int playouts) {
+    double total = 0.0;
+    int remaining = playouts;
+
+    while (remaining >= BoardBatch<32>::WIDTH) {
+        BoardBatch<32> batch;
+        batch.load(board, rng());
+        batch.playout();
+        total += batch.evaluateTerminal();
+        remaining -= BoardBatch<32>::WIDTH;
+    }
+    if (remaining >= BoardBatch<16>::WIDTH) {
+        BoardBatch<16> batch;
+        batch.load(board, rng());
+        batch.playout();
+        total += batch.evaluateTerminal();
+        remaining -= BoardBatch<16>::WIDTH;
+    }
+    while (remaining > 0) {
+        // Lanes past 'remaining' are played but not counted
+        BoardBatch<8> batch;
+        batch.load(board, rng());
+        batch.playout();
+        int lanes = remaining < BoardBatch<8>::WIDTH ? remaining : BoardBatch<8>::WIDTH;
+        total += batch.evaluateTerminal(nullptr, lanes);
+        remaining -= lanes;
+    }
+
+    return total;
+}
+
 /**
  * BACKPROPAGATION PHASE
  * Update all ancestor nodes with simulation result
@@ -299,13 +341,13 @@ double MCTS::simulate(HexukiBitboard& board, const MCTSConfig& config) {
  * Score is ALWAYS from Player 1's perspective (1.0 = P1 wins, 0.0 = P2 wins)
  * Each node stores wins from ITS playerToMove's perspective
  */
-void MCTS::backpropagate(MCTSNode* node, double score) {
+void MCTS::backpropagate(MCTSNode* node, double score, int playouts) {
     while (node != nullptr) {
         // Store score from this node's player perspective
         // If this is P1's node (P1 to move), use score as-is
         // If this is P2's node (P2 to move), invert (P2 wants opposite of P1)
-        double nodeScore = (node->playerToMove == PLAYER_1) ? score : (1.0 - score);
-        node->update(nodeScore);
+        double nodeScore = (node->playerToMove == PLAYER_1) ? score : (playouts - score);
+        node->update(nodeScore, playouts);
         node = node->parent;
     }
 }
@@ -314,8 +356,8 @@ void MCTS::backpropagate(MCTSNode* node, double score) {
 // Helper Functions
 // ============================================================================
 
-std::vector<Move> MCTS::getValidMoves(const HexukiBitboard& board) const {
-    return board.getValidMoves();
+void MCTS::getValidMoves(const HexukiBitboard& board, MoveList& moves) const {
+    board.generateMoves(moves);
 }
 
 bool MCTS::isTerminal(const HexukiBitboard& board) const {
@@ -337,9 +379,8 @@ double MCTS::evaluateTerminal(const HexukiBitboard& board) const {
     }
 }
 
-Move MCTS::selectRandomMove(const std::vector<Move>& moves) {
-    std::uniform_int_distribution<size_t> dist(0, moves.size() - 1);
-    return moves[dist(rng)];
+Move MCTS::selectRandomMove(const MoveGenerator& moves) {
+    return moves.random(rng);
 }
 
 } // namespace mcts
@@ -70,8 +70,8 @@ MCTSNode* MCTSNode::addChild(const Move& move) {
     return child;
 }
 
-void MCTSNode::update(double score) {
-    visits++;
+void MCTSNode::update(double score, int playouts) {
+    visits += playouts;
     totalScore += score;
 }
 
@@ -1,8 +1,14 @@
 #include "ai/minimax.h"
+#include "ai/endgame_solver.h"
+#include "ai/move_ordering.h"
 #include "core/zobrist.h"
+#include "core/move_generator.h"
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <thread>
 
 namespace hexuki {
 namespace minimax {
@@ -11,52 +17,28 @@ namespace minimax {
 constexpr int INF = 1000000;
 constexpr int MATE_SCORE = 900000;
 constexpr int TIMEOUT_CHECK_INTERVAL = 1000;  // Check time every 1000 nodes
-
-// ============================================================================
-// Transposition Table Implementation
-// ============================================================================
-
-TranspositionTable::TranspositionTable(size_t sizeMB)
-    : maxSize((sizeMB * 1024 * 1024) / sizeof(TTEntry))
-    , hits(0)
-    , misses(0) {
-    table.reserve(maxSize);  // Reserve full capacity to avoid rehashing
-}
-
-void TranspositionTable::store(uint64_t hash, const TTEntry& entry) {
-    // Always-replace strategy with depth preference for existing entries
-    auto it = table.find(hash);
-
-    if (it != table.end()) {
-        // Entry exists - replace only if new entry is deeper or same depth
-        if (entry.depth >= it->second.depth) {
-            it->second = entry;
+constexpr int ASPIRATION_WINDOW = 64;          // Initial half-width around the last score (x4 per failure)
+constexpr int ASPIRATION_MIN_DEPTH = 3;        // Shallower iterations use the full window
+constexpr int ETC_MIN_DEPTH = 3;               // Enhanced transposition cutoffs from this depth
+
+// When one thread's search has to stop. Once aborted, every node returns at
+// once without storing, so a cut-off search leaves nothing wrong in the TT.
+struct SearchLimits {
+    std::chrono::steady_clock::time_point startTime;
+    int timeLimitMs;
+    const std::atomic<bool>* stop;  // Lazy SMP helpers: set when the main thread is done
+    bool aborted;
+
+    // Check the clock and stop flag every TIMEOUT_CHECK_INTERVAL nodes
+    void check(int64_t nodesSearched) {
+        if (nodesSearched % TIMEOUT_CHECK_INTERVAL != 0) return;
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
+        if (elapsed >= timeLimitMs || (stop && stop->load(std::memory_order_relaxed))) {
+            aborted = true;
         }
-        // Otherwise keep the deeper entry
-    } else {
-        // Entry doesn't exist - always add it
-        // Let the hash map grow beyond maxSize if needed
-        // This ensures deep search results are always stored
-        table[hash] = entry;
-    }
-}
-
-bool TranspositionTable::probe(uint64_t hash, TTEntry& entry) const {
-    auto it = table.find(hash);
-    if (it != table.end()) {
-        entry = it->second;
-        hits++;
-        return true;
     }
-    misses++;
-    return false;
-}
-
-void TranspositionTable::clear() {
-    table.clear();
-    hits = 0;
-    misses = 0;
-}
+};
 
 // ============================================================================
 // Evaluation Function
@@ -80,29 +62,12 @@ int evaluate(const HexukiBitboard& board) {
 // Move Ordering
 // ============================================================================
 
-void orderMoves(std::vector<Move>& moves, HexukiBitboard& board, const TTEntry* ttEntry) {
+void orderMoves(MoveList& moves, HexukiBitboard& board, const TTEntry* ttEntry) {
     // In-place move ordering using lambda - no temporary allocations
 
-    // Lambda to calculate move score
+    // Lambda to calculate move score: TT move, then the static preference
     auto scoreMove = [&](const Move& move) -> int {
-        int score = 0;
-
-        // Bonus for TT move
-        if (ttEntry && move == ttEntry->bestMove) {
-            score += 1000000;
-        }
-
-        // Quick evaluation: prefer high-value tiles
-        score += move.tileValue * 100;
-
-        // Prefer moves to center area
-        // Center hexes: 4, 6, 7, 9, 11, 12
-        if (move.hexId == 9 || move.hexId == 4 || move.hexId == 6 ||
-            move.hexId == 7 || move.hexId == 11 || move.hexId == 12) {
-            score += 500;
-        }
-
-        return score;
+        return (ttEntry && move == ttEntry->bestMove ? 1000000 : 0) + staticMoveScore(move);
     };
 
     // Sort moves in-place by score (descending)
@@ -111,29 +76,76 @@ void orderMoves(std::vector<Move>& moves, HexukiBitboard& board, const TTEntry*
     });
 }
 
+// ============================================================================
+// Principal Variation
+// ============================================================================
+
+// Triangular PV table: row ply holds the best line found from that ply on.
+// A node clears its row on entry and, when a move raises alpha, rebuilds it
+// as that move followed by the child's row.
+struct PvTable {
+    Move moves[MAX_PLIES + 2][MAX_PLIES + 2];
+    int length[MAX_PLIES + 2];
+
+    void clear(int ply) { length[ply] = 0; }
+    void update(int ply, const Move& move) {
+        moves[ply][0] = move;
+        std::copy(moves[ply + 1], moves[ply + 1] + length[ply + 1], moves[ply] + 1);
+        length[ply] = length[ply + 1] + 1;
+    }
+};
+
+// Everything one search thread keeps to itself
+struct SearchThread {
+    PvTable pv;
+    MoveOrdering ordering;
+    bool useHeuristics = true;  // Killer/history/countermove ordering (SearchConfig::useSearchHeuristics)
+    bool useEnhancedCutoffs = false;  // SearchConfig::useEnhancedTranspositionCutoffs
+    bool useScoreBounds = true;       // SearchConfig::useScoreBounds
+    int endgamePlies = 5;             // SearchConfig::endgamePlies
+    int cutoffs = 0;            // Beta cutoffs at interior nodes
+    int firstMoveCutoffs = 0;   // ... of which by the first move searched
+    size_t ttHits = 0;          // TT probes that found their position
+    size_t ttMisses = 0;
+
+    // Counted here rather than in the (shared) table
+    bool probe(const TranspositionTable& tt, uint64_t hash, TTEntry& entry) {
+        bool hit = tt.probe(hash, entry);
+        ++(hit ? ttHits : ttMisses);
+        return hit;
+    }
+};
+
 // ============================================================================
 // Alpha-Beta Search
 // ============================================================================
 
-int alphaBeta(
+// Recursive search specialized for one rules policy (see core/rules.h)
+//
+// Principal variation search: the first (best-ordered) move gets the full
+// window, the rest a null window that only proves them worse, with a full
+// re-search when one turns out better. Nodes searched with a real window
+// (PV nodes) take no TT cutoffs, so their lines reach the PV table whole.
+template <typename R>
+static int alphaBetaWith(
     HexukiBitboard& board,
     int depth,
+    int ply,
     int alpha,
     int beta,
     TranspositionTable& tt,
-    int& nodesSearched,
-    std::chrono::steady_clock::time_point startTime,
-    int timeLimitMs
+    int64_t& nodesSearched,
+    SearchLimits& limits,
+    SearchThread& thread,
+    R rules
 ) {
     nodesSearched++;
+    thread.pv.clear(ply);
 
     // Check timeout periodically
-    if (nodesSearched % TIMEOUT_CHECK_INTERVAL == 0) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-        if (elapsed >= timeLimitMs) {
-            return 0;  // Timeout - return neutral score
-        }
+    limits.check(nodesSearched);
+    if (limits.aborted) {
+        return 0;  // Timeout - return neutral score
     }
 
     // Terminal node: game over or depth reached
@@ -141,12 +153,36 @@ int alphaBeta(
         return evaluate(board);
     }
 
-    uint64_t hash = board.getHash();
+    // Score bounds: every line from here (and every leaf evaluation below)
+    // ends with the margin in [lower, upper], so stop once that range alone
+    // settles the window (fail-soft: the bound is the returned score)
+    if (thread.useScoreBounds) {
+        ScoreBounds bounds = board.getScoreBounds();
+        int lower = bounds.marginLower(board.getCurrentPlayer());
+        int upper = bounds.marginUpper(board.getCurrentPlayer());
+        if (upper <= alpha || lower == upper) return upper;
+        if (lower >= beta) return lower;
+    }
+
+    bool pvNode = beta - alpha > 1;
+
+    // Last few plies of a solve: the endgame kernel (no TT, copy-make). PV
+    // nodes stay here so the PV table gets their lines.
+    int empty = NUM_HEXES - BitOps::popcount(board.getOccupiedMask());
+    if (!pvNode && empty <= thread.endgamePlies && depth >= empty) {
+        return solveEndgame(board, alpha, beta, nodesSearched, rules);
+    }
+
+    // Canonical key: symmetric positions share one entry. Entry moves are kept in
+    // canonical orientation and mapped through the (self-inverse) symmetry.
+    int symmetry = board.getCanonicalSymmetry();
+    uint64_t hash = board.getSymmetricHash(symmetry);
 
     // Transposition table lookup
     TTEntry ttEntry;
-    if (tt.probe(hash, ttEntry)) {
-        if (ttEntry.depth >= depth) {
+    if (thread.probe(tt, hash, ttEntry)) {
+        ttEntry.bestMove = ttEntry.bestMove.transformed(symmetry);
+        if (ttEntry.depth >= depth && !pvNode) {
             if (ttEntry.flag == TTEntry::EXACT) {
                 return ttEntry.score;
             } else if (ttEntry.flag == TTEntry::LOWER_BOUND) {
@@ -161,25 +197,68 @@ int alphaBeta(
         }
     }
 
-    // Get and order moves
-    std::vector<Move> moves = board.getValidMoves();
-
-    if (moves.empty()) {
-        // No moves available - game over
+    // No moves available - game over (checked from the masks before generating)
+    MoveGenerator generator(board, rules);
+    if (generator.empty()) {
         return evaluate(board);
     }
 
-    orderMoves(moves, board, &ttEntry);
+    // Enhanced transposition cutoff: a child already known (from the TT) to
+    // score >= beta for us refutes this node without searching anything
+    if (thread.useEnhancedCutoffs && !pvNode && depth >= ETC_MIN_DEPTH) {
+        MoveGenerator children = generator;  // Own cursor; generator is still unread
+        Move child;
+        while (children.next(child)) {
+            board.makeMove(child);
+            TTEntry childEntry;
+            bool hit = thread.probe(tt, board.getCanonicalHash(), childEntry);
+            board.unmakeMove();
+            if (hit && childEntry.depth >= depth - 1 && childEntry.flag != TTEntry::LOWER_BOUND
+                && -childEntry.score >= beta) {
+                tt.store(hash, TTEntry(-childEntry.score, depth, TTEntry::LOWER_BOUND, child.transformed(symmetry)));
+                return -childEntry.score;
+            }
+        }
+    }
+
+    // Moves best-first (stack-resident, no allocation), in stages: the TT move
+    // and killers are tried before anything is generated; the rest are ranked
+    // by countermove, then history, only as far as they get searched
+    int side = board.getCurrentPlayer() - 1;
+    Move previous = board.getLastMove();
+    Move staged[MAX_STAGED_MOVES] = {ttEntry.bestMove};
+    int stagedCount = 1;
+    if (thread.useHeuristics) {
+        staged[stagedCount++] = thread.ordering.getKiller(ply, 0);
+        staged[stagedCount++] = thread.ordering.getKiller(ply, 1);
+    }
+    MovePicker picker(generator, staged, stagedCount, [&](const Move& move) {
+        return thread.useHeuristics ? thread.ordering.score(move, ply, side, previous, ttEntry.bestMove)
+                                    : staticMoveScore(move);
+    });
 
     int bestScore = -INF;
-    Move bestMove = moves[0];
+    Move bestMove;
     TTEntry::Flag flag = TTEntry::UPPER_BOUND;
 
     // Search all moves
-    for (const auto& move : moves) {
+    bool firstMove = true;
+    Move move;
+    while (picker.next(move)) {
         board.makeMove(move);
-        int score = -alphaBeta(board, depth - 1, -beta, -alpha, tt, nodesSearched, startTime, timeLimitMs);
+        if (depth > 1) tt.prefetch(board.getCanonicalHash());  // Child probes its bucket next
+        int score;
+        if (firstMove) {
+            score = -alphaBetaWith(board, depth - 1, ply + 1, -beta, -alpha, tt, nodesSearched, limits, thread, rules);
+        } else {
+            score = -alphaBetaWith(board, depth - 1, ply + 1, -alpha - 1, -alpha, tt, nodesSearched, limits, thread, rules);
+            if (score > alpha && score < beta && !limits.aborted) {
+                score = -alphaBetaWith(board, depth - 1, ply + 1, -beta, -alpha, tt, nodesSearched, limits, thread, rules);
+            }
+        }
         board.unmakeMove(move);
+        if (limits.aborted) return 0;
+        firstMove = false;
 
         if (score > bestScore) {
             bestScore = score;
@@ -188,22 +267,257 @@ int alphaBeta(
             if (score > alpha) {
                 alpha = score;
                 flag = TTEntry::EXACT;
+                thread.pv.update(ply, move);
             }
         }
 
-        // Beta cutoff
+        // Beta cutoff: credit the move, debit the ones tried before it
         if (alpha >= beta) {
             flag = TTEntry::LOWER_BOUND;
+            thread.cutoffs++;
+            if (picker.picked() == 1) thread.firstMoveCutoffs++;
+            if (thread.useHeuristics) {
+                thread.ordering.recordCutoff(move, ply, side, previous, depth, picker.pickedMoves(), picker.picked() - 1);
+            }
             break;
         }
     }
 
     // Store in transposition table
-    tt.store(hash, TTEntry(bestScore, depth, flag, bestMove));
+    tt.store(hash, TTEntry(bestScore, depth, flag, bestMove.transformed(symmetry)));
 
     return bestScore;
 }
 
+int alphaBeta(
+    HexukiBitboard& board,
+    int depth,
+    int alpha,
+    int beta,
+    TranspositionTable& tt,
+    int64_t& nodesSearched,
+    std::chrono::steady_clock::time_point startTime,
+    int timeLimitMs
+) {
+    SearchLimits limits{startTime, timeLimitMs, nullptr, false};
+    SearchThread thread;
+    return dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        return alphaBetaWith(board, depth, 0, alpha, beta, tt, nodesSearched, limits, thread, rules);
+    });
+}
+
+// ============================================================================
+// Outcome Solver
+// ============================================================================
+
+// Outcome entries live in the score table under keys offset by this
+constexpr uint64_t OUTCOME_KEY = 0x9E3779B97F4A7C15ull;
+
+static int outcomeOf(int margin) {
+    return (margin > 0) - (margin < 0);
+}
+
+// Negamax over outcomes (-1 loss, 0 draw, 1 win for the side to move),
+// always to the end of the game, so every TT entry is final and its depth
+// (the empty hex count) only matters for replacement. Outcomes are a closed
+// range: a WIN lower bound or LOSS upper bound is stored as exact.
+template <typename R>
+static int solveWith(
+    HexukiBitboard& board,
+    int ply,
+    int alpha,
+    int beta,
+    TranspositionTable& tt,
+    int64_t& nodesSearched,
+    SearchLimits& limits,
+    SearchThread& thread,
+    R rules
+) {
+    nodesSearched++;
+    limits.check(nodesSearched);
+    if (limits.aborted) return 0;
+
+    if (board.isGameOver()) return outcomeOf(evaluate(board));
+
+    // The reachable margins may already settle the question
+    ScoreBounds bounds = board.getScoreBounds();
+    int lower = outcomeOf(bounds.marginLower(board.getCurrentPlayer()));
+    int upper = outcomeOf(bounds.marginUpper(board.getCurrentPlayer()));
+    if (upper <= alpha || lower == upper) return upper;
+    if (lower >= beta) return lower;
+
+    // Last few plies: the endgame kernel's margin has the same sign
+    int empty = NUM_HEXES - BitOps::popcount(board.getOccupiedMask());
+    if (empty <= thread.endgamePlies) {
+        return outcomeOf(solveEndgame(board, alpha, beta, nodesSearched, rules));
+    }
+
+    int symmetry = board.getCanonicalSymmetry();
+    uint64_t hash = board.getSymmetricHash(symmetry) ^ OUTCOME_KEY;
+
+    TTEntry ttEntry;
+    if (thread.probe(tt, hash, ttEntry)) {
+        ttEntry.bestMove = ttEntry.bestMove.transformed(symmetry);
+        if (ttEntry.flag == TTEntry::EXACT ||
+            (ttEntry.flag == TTEntry::LOWER_BOUND && ttEntry.score >= beta) ||
+            (ttEntry.flag == TTEntry::UPPER_BOUND && ttEntry.score <= alpha)) {
+            return ttEntry.score;
+        }
+    }
+
+    MoveGenerator generator(board, rules);
+    if (generator.empty()) return outcomeOf(evaluate(board));
+
+    int side = board.getCurrentPlayer() - 1;
+    Move previous = board.getLastMove();
+    Move staged[MAX_STAGED_MOVES] = {ttEntry.bestMove, thread.ordering.getKiller(ply, 0),
+                                     thread.ordering.getKiller(ply, 1)};
+    MovePicker picker(generator, staged, MAX_STAGED_MOVES, [&](const Move& move) {
+        return thread.ordering.score(move, ply, side, previous, ttEntry.bestMove);
+    });
+
+    int originalAlpha = alpha;
+    int bestScore = -INF;
+    Move bestMove;
+    Move move;
+    while (picker.next(move)) {
+        board.makeMove(move);
+        tt.prefetch(board.getCanonicalHash() ^ OUTCOME_KEY);
+        int score = -solveWith(board, ply + 1, -beta, -alpha, tt, nodesSearched, limits, thread, rules);
+        board.unmakeMove(move);
+        if (limits.aborted) return 0;
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            alpha = std::max(alpha, score);
+        }
+        if (alpha >= beta) {
+            thread.cutoffs++;
+            if (picker.picked() == 1) thread.firstMoveCutoffs++;
+            thread.ordering.recordCutoff(move, ply, side, previous, empty, picker.pickedMoves(), picker.picked() - 1);
+            break;
+        }
+    }
+
+    TTEntry::Flag flag = TTEntry::EXACT;
+    if (bestScore >= beta && bestScore < 1) flag = TTEntry::LOWER_BOUND;
+    if (bestScore <= originalAlpha && bestScore > -1) flag = TTEntry::UPPER_BOUND;
+    tt.store(hash, TTEntry(bestScore, empty, flag, bestMove.transformed(symmetry)));
+
+    return bestScore;
+}
+
+Outcome solveOutcome(HexukiBitboard& board, TranspositionTable& tt, int64_t& nodesSearched, int timeLimitMs) {
+    SearchLimits limits{std::chrono::steady_clock::now(), timeLimitMs, nullptr, false};
+    SearchThread thread;
+    return dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        // Better than a draw? If not: at least a draw?
+        int score = solveWith(board, 0, 0, 1, tt, nodesSearched, limits, thread, rules);
+        if (score < 1 && !limits.aborted) {
+            score = solveWith(board, 0, -1, 0, tt, nodesSearched, limits, thread, rules);
+        }
+        if (limits.aborted) return Outcome::UNKNOWN;
+        return score >= 1 ? Outcome::WIN : (score >= 0 ? Outcome::DRAW : Outcome::LOSS);
+    });
+}
+
+Outcome solveOutcome(HexukiBitboard& board) {
+    thread_local TranspositionTable tt(16);
+    int64_t nodesSearched = 0;
+    return solveOutcome(board, tt, nodesSearched);
+}
+
+// ============================================================================
+// Root Search
+// ============================================================================
+
+// Root move with what the last iteration learned about it
+struct RootMove {
+    Move move;
+    int score = -INF;  // Last score (a bound unless it was the best move)
+    int64_t nodes = 0; // Size of its last subtree
+};
+
+// One iteration over the root moves (PVS, as in alphaBetaWith) within
+// (alpha, beta). Records each move's score and subtree size; the best line
+// ends up in pv row 0. Returns the best score (<= alpha: failed low).
+template <typename R>
+static int searchRoot(
+    HexukiBitboard& board,
+    std::vector<RootMove>& rootMoves,
+    int depth,
+    int alpha,
+    int beta,
+    TranspositionTable& tt,
+    int64_t& nodesSearched,
+    SearchLimits& limits,
+    SearchThread& thread,
+    R rules
+) {
+    int bestScore = -INF;
+    thread.pv.clear(0);
+    for (size_t i = 0; i < rootMoves.size(); i++) {
+        RootMove& root = rootMoves[i];
+        int64_t nodesBefore = nodesSearched;
+        board.makeMove(root.move);
+        int score;
+        if (i == 0) {
+            score = -alphaBetaWith(board, depth - 1, 1, -beta, -alpha, tt, nodesSearched, limits, thread, rules);
+        } else {
+            score = -alphaBetaWith(board, depth - 1, 1, -alpha - 1, -alpha, tt, nodesSearched, limits, thread, rules);
+            if (score > alpha && score < beta && !limits.aborted) {
+                score = -alphaBetaWith(board, depth - 1, 1, -beta, -alpha, tt, nodesSearched, limits, thread, rules);
+            }
+        }
+        board.unmakeMove(root.move);
+        if (limits.aborted) break;
+
+        root.score = score;
+        root.nodes = nodesSearched - nodesBefore;
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                alpha = score;
+                thread.pv.update(0, root.move);
+            }
+        }
+        if (alpha >= beta) break;
+    }
+    return bestScore;
+}
+
+// ============================================================================
+// Lazy SMP
+// ============================================================================
+
+// Helper thread: iterative deepening over the same root on its own board,
+// until stopped. Odd helpers run one ply ahead and each starts the root
+// moves at a different offset, so threads fill the shared TT with different
+// subtrees; their results are only used through the TT.
+static void helperSearch(
+    HexukiBitboard board,
+    std::vector<RootMove> rootMoves,
+    int helper,
+    const SearchConfig& config,
+    TranspositionTable& tt,
+    int64_t& nodesSearched,
+    SearchLimits limits,
+    SearchThread& thread
+) {
+    std::rotate(rootMoves.begin(), rootMoves.begin() + helper % rootMoves.size(), rootMoves.end());
+    thread.useHeuristics = config.useSearchHeuristics;
+    thread.useEnhancedCutoffs = config.useEnhancedTranspositionCutoffs;
+    thread.useScoreBounds = config.useScoreBounds;
+    thread.endgamePlies = std::min(config.endgamePlies, ENDGAME_MAX_PLIES);
+
+    dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        for (int depth = 1 + helper % 2; depth <= config.maxDepth && !limits.aborted; depth++) {
+            searchRoot(board, rootMoves, depth, -INF, INF, tt, nodesSearched, limits, thread, rules);
+        }
+    });
+}
+
 // ============================================================================
 // Quiescence Search
 // ============================================================================
@@ -213,7 +527,7 @@ int quiescence(
     int alpha,
     int beta,
     TranspositionTable& tt,
-    int& nodesSearched
+    int64_t& nodesSearched
 ) {
     nodesSearched++;
 
@@ -242,10 +556,15 @@ SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config) {
 
     auto startTime = std::chrono::steady_clock::now();
 
-    // Initialize transposition table
-    TranspositionTable tt(config.ttSizeMB);
+    // Transposition table: the caller's (kept and aged across searches), or
+    // one of ttSizeMB for this search only, freed on return
+    std::unique_ptr<TranspositionTable> ownTT;
+    if (!config.tt) ownTT = std::make_unique<TranspositionTable>(config.ttSizeMB);
+    TranspositionTable& tt = config.tt ? *config.tt : *ownTT;
+    tt.newSearch();
 
-    std::vector<Move> moves = board.getValidMoves();
+    MoveList moves;
+    board.generateMoves(moves);
 
     if (moves.empty()) {
         // No legal moves
@@ -254,87 +573,95 @@ SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config) {
         return result;
     }
 
-    if (moves.size() == 1) {
-        // Only one move - still need to search ahead to get accurate score!
-        // Don't just return current evaluation - make the move and evaluate the resulting position
-        result.bestMove = moves[0];
-
-        // Make the move, search the resulting position, then unmake
-        board.makeMove(moves[0]);
-        int nodesSearched = 0;
-        result.score = -alphaBeta(board, config.maxDepth - 1, -INF, INF, tt, nodesSearched, startTime, config.timeLimitMs);
-        board.unmakeMove(moves[0]);
-
-        result.depth = config.maxDepth;
-        result.nodesSearched = nodesSearched;
-
-        auto endTime = std::chrono::steady_clock::now();
-        result.timeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
-
-        return result;
+    if (config.useMoveOrdering) {
+        orderMoves(moves, board, nullptr);
+    }
+    std::vector<RootMove> rootMoves(moves.size());
+    for (size_t i = 0; i < moves.size(); i++) rootMoves[i].move = moves[i];
+
+    SearchLimits limits{startTime, config.timeLimitMs, nullptr, false};
+    SearchThread thread;
+    thread.useHeuristics = config.useSearchHeuristics;
+    thread.useEnhancedCutoffs = config.useEnhancedTranspositionCutoffs;
+    thread.useScoreBounds = config.useScoreBounds;
+    thread.endgamePlies = std::min(config.endgamePlies, ENDGAME_MAX_PLIES);
+
+    // Lazy SMP: helpers search the same root into the shared TT until the
+    // main thread (which alone decides the result) is done
+    int helperCount = config.useIterativeDeepening && moves.size() > 1 ? std::max(config.threads, 1) - 1 : 0;
+    std::vector<int64_t> helperNodes(helperCount, 0);
+    std::vector<SearchThread> helperThreads(helperCount);  // Read back for their TT stats after the join
+    std::vector<std::thread> helpers;
+    std::atomic<bool> stopHelpers(false);
+    for (int i = 0; i < helperCount; i++) {
+        SearchLimits helperLimits{startTime, config.timeLimitMs, &stopHelpers, false};
+        helpers.emplace_back(helperSearch, board, rootMoves, i + 1, std::cref(config), std::ref(tt), std::ref(helperNodes[i]), helperLimits,
+                             std::ref(helperThreads[i]));
     }
 
     Move bestMove = moves[0];
     int bestScore = -INF;
+    int64_t nodesSearched = 0;
 
-    if (config.useIterativeDeepening) {
-        // Iterative deepening: search 1, 2, 3, ..., maxDepth
-        for (int depth = 1; depth <= config.maxDepth; depth++) {
-            int nodesSearched = 0;
+    dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        // Iterative deepening: search 1, 2, 3, ..., maxDepth (or maxDepth only).
+        // A single legal move still gets searched, for its score.
+        int firstDepth = config.useIterativeDeepening && moves.size() > 1 ? 1 : config.maxDepth;
+        for (int depth = firstDepth; depth <= config.maxDepth; depth++) {
+            int64_t depthNodes = 0;
+
+            // Aspiration window around the last score, widened on failure
+            int delta = ASPIRATION_WINDOW;
             int alpha = -INF;
             int beta = INF;
-
-            Move currentBestMove;
-            int currentBestScore = -INF;
-
-            // Order moves based on previous iteration's best
-            if (depth > 1) {
-                orderMoves(moves, board, nullptr);
+            if (depth >= ASPIRATION_MIN_DEPTH && bestScore > -INF) {
+                alpha = std::max(bestScore - delta, -INF);
+                beta = std::min(bestScore + delta, INF);
             }
 
-            // Search all moves at current depth
-            bool depthTimedOut = false;
-            long long elapsed = 0;
-            for (const auto& move : moves) {
-                board.makeMove(move);
-                int score = -alphaBeta(board, depth - 1, -beta, -alpha, tt, nodesSearched, startTime, config.timeLimitMs);
-                board.unmakeMove(move);
-
-                // Check if we timed out during this search
-                auto now = std::chrono::steady_clock::now();
-                elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
-                if (elapsed >= config.timeLimitMs) {
-                    depthTimedOut = true;
+            int score;
+            while (true) {
+                score = searchRoot(board, rootMoves, depth, alpha, beta, tt, depthNodes, limits, thread, rules);
+                if (limits.aborted) break;
+                if (score <= alpha && alpha > -INF) {
+                    alpha = std::max(score - delta, -INF);
+                } else if (score >= beta && beta < INF) {
+                    beta = std::min(score + delta, INF);
+                } else {
                     break;
                 }
-
-                if (score > currentBestScore) {
-                    currentBestScore = score;
-                    currentBestMove = move;
-
-                    if (score > alpha) {
-                        alpha = score;
-                    }
-                }
+                delta *= 4;
             }
 
             // If we timed out mid-depth, don't use this depth's results - use previous depth
-            if (depthTimedOut) {
+            if (limits.aborted) {
                 result.timeout = true;
                 break;
             }
 
             // Update best move from this COMPLETED depth
-            bestMove = currentBestMove;
-            bestScore = currentBestScore;
+            bestMove = thread.pv.moves[0][0];
+
+            // Next iteration: best move first, then by score (bounds for the
+            // rest) and by subtree size (moves that took longer to refute first)
+            std::stable_sort(rootMoves.begin(), rootMoves.end(), [&](const RootMove& a, const RootMove& b) {
+                if ((a.move == bestMove) != (b.move == bestMove)) return a.move == bestMove;
+                return a.score != b.score ? a.score > b.score : a.nodes > b.nodes;
+            });
+
+            bestScore = score;
             result.depth = depth;
-            result.nodesSearched += nodesSearched;
+            nodesSearched += depthNodes;
+            result.pv.assign(thread.pv.moves[0], thread.pv.moves[0] + thread.pv.length[0]);
 
             if (config.verbose) {
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - startTime).count();
                 std::cout << "Depth " << depth << ": score=" << bestScore
                           << " move=" << bestMove.toString()
-                          << " nodes=" << nodesSearched
-                          << " time=" << elapsed << "ms" << std::endl;
+                          << " nodes=" << depthNodes
+                          << " time=" << elapsed << "ms"
+                          << " pv=" << formatPv(result.pv) << std::endl;
             }
 
             // Stop if mate found
@@ -342,33 +669,15 @@ SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config) {
                 break;
             }
         }
-    } else {
-        // Single depth search
-        int nodesSearched = 0;
-        int alpha = -INF;
-        int beta = INF;
-
-        if (config.useMoveOrdering) {
-            orderMoves(moves, board, nullptr);
-        }
-
-        for (const auto& move : moves) {
-            board.makeMove(move);
-            int score = -alphaBeta(board, config.maxDepth - 1, -beta, -alpha, tt, nodesSearched, startTime, config.timeLimitMs);
-            board.unmakeMove(move);
-
-            if (score > bestScore) {
-                bestScore = score;
-                bestMove = move;
-
-                if (score > alpha) {
-                    alpha = score;
-                }
-            }
-        }
+    });
 
-        result.nodesSearched = nodesSearched;
-        result.depth = config.maxDepth;
+    stopHelpers = true;
+    for (std::thread& helper : helpers) helper.join();
+    result.nodesSearched = nodesSearched;
+    result.threadNodes.push_back(nodesSearched);
+    for (int64_t nodes : helperNodes) {
+        result.threadNodes.push_back(nodes);
+        result.nodesSearched += nodes;
     }
 
     auto endTime = std::chrono::steady_clock::now();
@@ -376,12 +685,27 @@ SearchResult findBestMove(HexukiBitboard& board, const SearchConfig& config) {
 
     result.bestMove = bestMove;
     result.score = bestScore;
-    result.ttHits = tt.getHits();
-    result.ttMisses = tt.getMisses();
+    result.ttHits = thread.ttHits;
+    result.ttMisses = thread.ttMisses;
+    for (const SearchThread& helper : helperThreads) {
+        result.ttHits += helper.ttHits;
+        result.ttMisses += helper.ttMisses;
+    }
+    result.cutoffs = thread.cutoffs;
+    result.firstMoveCutoffs = thread.firstMoveCutoffs;
 
     return result;
 }
 
+std::string formatPv(const std::vector<Move>& pv) {
+    std::string text;
+    for (const Move& move : pv) {
+        if (!text.empty()) text += ' ';
+        text += move.toString();
+    }
+    return text;
+}
+
 // Simple interface
 SearchResult findBestMove(HexukiBitboard& board, int depth, int timeLimitMs) {
     SearchConfig config;
@@ -0,0 +1,154 @@
+#include "ai/transposition_table.h"
+#include <algorithm>
+
+namespace hexuki {
+namespace minimax {
+
+// ============================================================================
+// Entry packing: data word layout
+//   bits  0-31  score (two's complement)
+//   bits 32-39  depth (clamped to 255)
+//   bits 40-41  flag
+//   bits 42-47  generation
+//   bits 48-55  move: hexId * NUM_TILES_PER_PLAYER + tile slot + 1 (0 = none)
+//   bit  56     valid (an all-zero slot is empty)
+// ============================================================================
+
+namespace {
+
+constexpr int GENERATION_BITS = 6;
+constexpr uint8_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+constexpr int AGE_WEIGHT = 8;  // Replacement: one search of age counts as 8 plies of depth
+constexpr uint64_t VALID_BIT = 1ull << 56;
+
+static_assert(NUM_HEXES * NUM_TILES_PER_PLAYER < 255, "Moves must pack into one byte");
+
+uint8_t packMove(const Move& move) {
+    if (move.hexId < 0 || move.tileValue > MAX_TILE_VALUE || TILE_SLOTS[move.tileValue] < 0) return 0;
+    return static_cast<uint8_t>(move.hexId * NUM_TILES_PER_PLAYER + TILE_SLOTS[move.tileValue] + 1);
+}
+
+Move unpackMove(uint8_t code) {
+    if (code == 0) return Move();
+    return Move((code - 1) / NUM_TILES_PER_PLAYER, TILE_VALUES[(code - 1) % NUM_TILES_PER_PLAYER]);
+}
+
+uint64_t packEntry(const TTEntry& entry, uint8_t generation) {
+    uint64_t depth = static_cast<uint64_t>(std::min(std::max(entry.depth, 0), 255));
+    return static_cast<uint32_t>(entry.score)
+         | (depth << 32)
+         | (static_cast<uint64_t>(entry.flag) << 40)
+         | (static_cast<uint64_t>(generation) << 42)
+         | (static_cast<uint64_t>(packMove(entry.bestMove)) << 48)
+         | VALID_BIT;
+}
+
+TTEntry unpackEntry(uint64_t data) {
+    return TTEntry(static_cast<int32_t>(static_cast<uint32_t>(data)),
+                   static_cast<int>((data >> 32) & 0xFF),
+                   static_cast<TTEntry::Flag>((data >> 40) & 0x3),
+                   unpackMove(static_cast<uint8_t>(data >> 48)));
+}
+
+int entryDepth(uint64_t data) { return static_cast<int>((data >> 32) & 0xFF); }
+uint8_t entryGeneration(uint64_t data) { return static_cast<uint8_t>((data >> 42) & GENERATION_MASK); }
+
+} // namespace
+
+// ============================================================================
+// Transposition Table Implementation
+// ============================================================================
+
+TranspositionTable::TranspositionTable(size_t sizeMB)
+    : bucketMask(0)
+    , sizeMB(0)
+    , generation(0) {
+    resize(sizeMB);
+}
+
+void TranspositionTable::resize(size_t newSizeMB) {
+    if (buckets && newSizeMB == sizeMB) return;
+
+    // Largest power of two number of buckets that fits the budget (at least one)
+    size_t budget = (newSizeMB * 1024 * 1024) / sizeof(Bucket);
+    size_t count = 1;
+    while (count * 2 <= budget) count *= 2;
+
+    buckets.reset();  // Free the old table before allocating the new one
+    buckets.reset(new Bucket[count]());  // Zeroed: every slot empty
+    bucketMask = count - 1;
+    sizeMB = newSizeMB;
+    generation = 0;
+}
+
+void TranspositionTable::store(uint64_t hash, const TTEntry& entry) {
+    Bucket& bucket = buckets[hash & bucketMask];
+    uint64_t data = packEntry(entry, generation);
+
+    // Same position: overwrite unless the stored result is deeper and current
+    Slot* victim = nullptr;
+    int victimValue = 0;
+    for (Slot& slot : bucket.slots) {
+        uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+        uint64_t oldKey = slot.keyXorData.load(std::memory_order_relaxed) ^ oldData;
+
+        if (oldKey == hash && (oldData & VALID_BIT)) {
+            if (entry.depth < entryDepth(oldData) && entryGeneration(oldData) == generation) return;
+            victim = &slot;
+            break;
+        }
+
+        // Otherwise replace the least valuable entry: empty, then shallow and old
+        int age = (generation - entryGeneration(oldData)) & GENERATION_MASK;
+        int value = (oldData & VALID_BIT) ? entryDepth(oldData) - AGE_WEIGHT * age : -1000;
+        if (!victim || value < victimValue) {
+            victim = &slot;
+            victimValue = value;
+        }
+    }
+
+    victim->keyXorData.store(hash ^ data, std::memory_order_relaxed);
+    victim->data.store(data, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::probe(uint64_t hash, TTEntry& entry) const {
+    const Bucket& bucket = buckets[hash & bucketMask];
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+        if ((keyXorData ^ data) == hash && (data & VALID_BIT)) {
+            entry = unpackEntry(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= bucketMask; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = (generation + 1) & GENERATION_MASK;
+}
+
+int TranspositionTable::getUsagePermille() const {
+    size_t sampleBuckets = std::min<size_t>(bucketMask + 1, 1000 / BUCKET_ENTRIES);
+    int used = 0;
+    for (size_t i = 0; i < sampleBuckets; i++) {
+        for (const Slot& slot : buckets[i].slots) {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            if ((data & VALID_BIT) && entryGeneration(data) == generation) used++;
+        }
+    }
+    return static_cast<int>(used * 1000 / (sampleBuckets * BUCKET_ENTRIES));
+}
+
+} // namespace minimax
+} // namespace hexuki
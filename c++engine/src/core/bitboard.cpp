@@ -1,11 +1,14 @@
 #include "core/bitboard.h"
 #include "core/zobrist.h"
+#include "core/move_generator.h"
+#include "core/notation.h"
 #include "utils/timer.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <cstring>
-#include <set>
+#include <cstdlib>
+#include <cassert>
 
 #ifdef _MSC_VER
 #include <intrin.h>
@@ -13,18 +16,6 @@
 
 namespace hexuki {
 
-// ============================================================================
-// Helper Functions
-// ============================================================================
-
-// Check if two tile vectors are identical (same values in any order)
-static bool tilesMatch(std::vector<int> tiles1, std::vector<int> tiles2) {
-    if (tiles1.size() != tiles2.size()) return false;
-    std::sort(tiles1.begin(), tiles1.end());
-    std::sort(tiles2.begin(), tiles2.end());
-    return tiles1 == tiles2;
-}
-
 // ============================================================================
 // Constructor & Reset
 // ============================================================================
@@ -32,13 +23,19 @@ static bool tilesMatch(std::vector<int> tiles1, std::vector<int> tiles2) {
 HexukiBitboard::HexukiBitboard()
     : hexOccupied(0)
     , hexValues{}
-    , p1AvailableTiles(ALL_TILES_MASK)  // All tiles 1-NUM_TILE_VALUES available
-    , p2AvailableTiles(ALL_TILES_MASK)
+    , p1Tiles(FULL_TILE_INVENTORY)  // One of each TILE_VALUES tile
+    , p2Tiles(FULL_TILE_INVENTORY)
     , currentPlayer(PLAYER_1)
-    , symmetryStillPossible(true)
+    , mirrorMismatch(0)
+    , ruleFlags(DEFAULT_RULE_FLAGS)
     , tilesAreIdentical(true)
-    , zobristHash(0)
+    , zobristHashes{}
+    , chainProducts{}
+    , playerScores{}
+    , undoStack{}
+    , undoCount(0)
 {
+    LegalMaskTable::initialize();
     reset();
 }
 
@@ -47,20 +44,24 @@ void HexukiBitboard::reset() {
     hexOccupied = 0;
     std::memset(hexValues, 0, sizeof(hexValues));
 
-    // Reset available tiles (all tiles 1-9 available)
-    // Array-based: supports standard [1,2,3,4,5,6,7,8,9] and asymmetric sets
-    p1AvailableTiles = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-    p2AvailableTiles = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    // Reset available tiles (one of each tile value)
+    // Packed counts: supports standard [1,2,3,4,5,6,7,8,9] and asymmetric sets
+    p1Tiles = FULL_TILE_INVENTORY;
+    p2Tiles = FULL_TILE_INVENTORY;
 
-    // Initial state: center hex (9) has tile value 1
-    hexOccupied = (1u << CENTER_HEX);
-    hexValues[CENTER_HEX] = STARTING_TILE;
+    // Initial state: center hex (9) has tile value 1 (unless the variant starts empty)
+    if (ruleFlags & RULE_CENTER_START) {
+        hexOccupied = (1u << CENTER_HEX);
+        hexValues[CENTER_HEX] = STARTING_TILE;
+    }
+    rebuildScores();
+    rebuildMirrorMismatch();
+    undoCount = 0;
 
     currentPlayer = PLAYER_1;
-    symmetryStillPossible = true;
-    tilesAreIdentical = tilesMatch(p1AvailableTiles, p2AvailableTiles);
+    tilesAreIdentical = (p1Tiles == p2Tiles);
 
-    zobristHash = Zobrist::hash(*this);
+    rebuildHashes();
 }
 
 // ============================================================================
@@ -80,293 +81,93 @@ int HexukiBitboard::getTileValue(int hexId) const {
 bool HexukiBitboard::isGameOver() const {
     // Game ends when all 19 hexes are filled
     // Can't use moveCount >= 18 because puzzles might have empty center hex (allowing 19 moves)
-    int occupiedCount = 0;
-    for (int i = 0; i < NUM_HEXES; i++) {
-        if (isHexOccupied(i)) occupiedCount++;
-    }
-    return occupiedCount >= NUM_HEXES;
+    return hexOccupied == ALL_HEXES_MASK;
 }
 
 bool HexukiBitboard::isTileAvailable(int player, int tileValue) const {
-    if (tileValue < 1 || tileValue > MAX_TILE_VALUE) return false;
-    const std::vector<int>& tiles = (player == PLAYER_1) ? p1AvailableTiles : p2AvailableTiles;
-    // Use std::find to check if tile value exists in array (supports duplicates)
-    return std::find(tiles.begin(), tiles.end(), tileValue) != tiles.end();
-}
-
-std::vector<int> HexukiBitboard::getAvailableTiles(int player) const {
-    // Simply return the tile array (already supports duplicates)
-    return (player == PLAYER_1) ? p1AvailableTiles : p2AvailableTiles;
+    return getTileCount(player, tileValue) > 0;
 }
 
-// ============================================================================
-// Adjacency (REAL hex grid adjacency)
-// ============================================================================
-
-int HexukiBitboard::findHexAt(int row, int col) const {
-    for (int i = 0; i < NUM_HEXES; i++) {
-        if (HEX_POSITIONS[i].row == row && HEX_POSITIONS[i].col == col) {
-            return i;
-        }
-    }
-    return -1;  // Not found
-}
-
-std::vector<int> HexukiBitboard::getAdjacentHexes(int hexId) const {
-    std::vector<int> adjacent;
-    if (hexId < 0 || hexId >= NUM_HEXES) return adjacent;
-
-    const HexPosition& hex = HEX_POSITIONS[hexId];
-
-    // Check all 6 hex directions
-    for (int i = 0; i < 6; i++) {
-        int newRow = hex.row + HEX_DIRECTIONS[i].dr;
-        int newCol = hex.col + HEX_DIRECTIONS[i].dc;
-
-        int adjId = findHexAt(newRow, newCol);
-        if (adjId >= 0) {
-            adjacent.push_back(adjId);
-        }
-    }
-
-    return adjacent;
+int HexukiBitboard::getTileCount(int player, int tileValue) const {
+    if (tileValue < 1 || tileValue > MAX_TILE_VALUE) return 0;
+    int slot = TILE_SLOTS[tileValue];
+    if (slot < 0) return 0;
+    return static_cast<int>((getTileInventory(player) >> (slot * TILE_COUNT_BITS)) & TILE_COUNT_MASK);
 }
 
-bool HexukiBitboard::hasAdjacentOccupied(int hexId) const {
-    auto adjacent = getAdjacentHexes(hexId);
-    for (int adjId : adjacent) {
-        if (isHexOccupied(adjId)) {
-            return true;
-        }
+std::vector<int> HexukiBitboard::getAvailableTiles(int player) const {
+    // Expand packed counts into a tile list (duplicates repeated)
+    std::vector<int> tiles;
+    uint64_t inventory = getTileInventory(player);
+    for (int slot = 0; slot < NUM_TILES_PER_PLAYER; slot++) {
+        int count = static_cast<int>((inventory >> (slot * TILE_COUNT_BITS)) & TILE_COUNT_MASK);
+        tiles.insert(tiles.end(), count, TILE_VALUES[slot]);
     }
-    return false;
+    return tiles;
 }
 
 // ============================================================================
-// Chain Length Constraint (REAL algorithm from JavaScript)
+// Variant Rules
 // ============================================================================
 
-std::vector<int> HexukiBitboard::getChainLengthsFromStart(int startHex, const Direction& dir) const {
-    std::vector<int> lengths;
-    int currentLength = 0;
-    int currentHex = startHex;
-
-    while (currentHex >= 0) {
-        if (isHexOccupied(currentHex)) {
-            currentLength++;
-        } else if (currentLength > 0) {
-            // Hit empty cell, record current chain and reset
-            lengths.push_back(currentLength);
-            currentLength = 0;
-        }
-
-        // Move to next cell in direction
-        const HexPosition& pos = HEX_POSITIONS[currentHex];
-        int newRow = pos.row + dir.dr;
-        int newCol = pos.col + dir.dc;
-        currentHex = findHexAt(newRow, newCol);
-    }
-
-    // Record final chain if we ended on occupied cells
-    if (currentLength > 0) {
-        lengths.push_back(currentLength);
+void HexukiBitboard::setRuleFlags(uint8_t flags) {
+    ruleFlags = flags & ALL_RULE_FLAGS;
+    if (!(ruleFlags & RULE_CHAIN_CONSTRAINT)) {
+        LegalMaskTable::initializeAdjacent();
     }
-
-    return lengths;
-}
-
-std::vector<int> HexukiBitboard::getAllChainLengths() const {
-    std::vector<int> chainLengths;
-
-    // Check all chain starters
-    for (int i = 0; i < 15; i++) {
-        const ChainStarter& starter = CHAIN_STARTERS[i];
-        auto lengths = getChainLengthsFromStart(starter.startHex, starter.dir);
-        chainLengths.insert(chainLengths.end(), lengths.begin(), lengths.end());
-    }
-
-    return chainLengths;
+    rebuildHashes();  // Positions under different rules never share a key
 }
 
-std::vector<HexukiBitboard::ChainInfo> HexukiBitboard::getAllChainsWithMembers() const {
-    std::vector<ChainInfo> chains;
-
-    // Check all chain starters
-    for (int i = 0; i < 15; i++) {
-        const ChainStarter& starter = CHAIN_STARTERS[i];
-        std::vector<int> currentChain;
-        int currentHex = starter.startHex;
-
-        while (currentHex >= 0) {
-            if (isHexOccupied(currentHex)) {
-                currentChain.push_back(currentHex);
-            } else if (!currentChain.empty()) {
-                // Hit empty cell, record current chain and reset
-                ChainInfo info;
-                info.length = currentChain.size();
-                info.hexIds = currentChain;
-                chains.push_back(info);
-                currentChain.clear();
-            }
-
-            // Move to next cell in direction
-            const HexPosition& pos = HEX_POSITIONS[currentHex];
-            int newRow = pos.row + starter.dir.dr;
-            int newCol = pos.col + starter.dir.dc;
-            currentHex = findHexAt(newRow, newCol);
-        }
-
-        // Record final chain if we ended on occupied cells
-        if (!currentChain.empty()) {
-            ChainInfo info;
-            info.length = currentChain.size();
-            info.hexIds = currentChain;
-            chains.push_back(info);
-        }
-    }
+// ============================================================================
+// Anti-Symmetry Rule (REAL algorithm from JavaScript)
+// ============================================================================
 
-    // Find isolated tiles (occupied hexes not part of any detected chain)
-    std::set<int> hexesInChains;
-    for (const auto& chain : chains) {
-        for (int hexId : chain.hexIds) {
-            hexesInChains.insert(hexId);
-        }
-    }
+bool HexukiBitboard::createsMirroredBoard(const Move& move) const {
+    if (!isAntiSymmetryActive()) return false;
 
-    // Add isolated tiles as 1-chains
-    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
-        if (isHexOccupied(hexId) && hexesInChains.find(hexId) == hexesInChains.end()) {
-            ChainInfo info;
-            info.length = 1;
-            info.hexIds = {hexId};
-            chains.push_back(info);
-        }
+    // Center column hexes mirror onto themselves: the board stays as (a)symmetric as it was
+    int mirrorHexId = VERTICAL_MIRROR_PAIRS[move.hexId];
+    if (mirrorHexId == move.hexId) {
+        return mirrorMismatch == 0;
     }
 
-    return chains;
-}
-
-void HexukiBitboard::getFirstAndSecondChainLengths(int& first, int& second) const {
-    auto allLengths = getAllChainLengths();
-    first = 0;
-    second = 0;
-
-    for (int length : allLengths) {
-        if (length > first) {
-            second = first;
-            first = length;
-        } else if (length > second) {
-            second = length;
-        }
-    }
+    // Otherwise the move must close the only mismatched pair by copying its mirror
+    return mirrorMismatch == mirrorPairMask(move.hexId) && hexValues[mirrorHexId] == move.tileValue;
 }
 
-bool HexukiBitboard::checkChainLengthConstraint(int hexId) const {
-    // Make a test board with the proposed move
-    HexukiBitboard testBoard = *this;
-    testBoard.hexOccupied |= (1u << hexId);
-    testBoard.hexValues[hexId] = 1;  // Use dummy value for testing
-
-    // Get all chains with their member hexes
-    auto allChains = testBoard.getAllChainsWithMembers();
-
-    // Find chains that contain the newly placed hexId (affected chains)
-    int longestAffected = 0;
-    for (const auto& chain : allChains) {
-        bool containsNewHex = std::find(chain.hexIds.begin(), chain.hexIds.end(), hexId) != chain.hexIds.end();
-        if (containsNewHex && chain.length > longestAffected) {
-            longestAffected = chain.length;
-        }
-    }
-
-    // Get all chain lengths and sort descending
-    std::vector<int> allLengths;
-    for (const auto& chain : allChains) {
-        allLengths.push_back(chain.length);
-    }
-    std::sort(allLengths.begin(), allLengths.end(), std::greater<int>());
-
-    // Get second longest chain on entire board
-    int secondLongest = allLengths.size() >= 2 ? allLengths[1] : 0;
-
-    // Rule: longest affected chain can be at most 1 longer than second longest
-    if (longestAffected > secondLongest + 1) {
-        return false;
+void HexukiBitboard::updateMirrorMismatch(int hexId) {
+    uint32_t pair = mirrorPairMask(hexId);
+    if (hexValues[hexId] != hexValues[VERTICAL_MIRROR_PAIRS[hexId]]) {
+        mirrorMismatch |= pair;
+    } else {
+        mirrorMismatch &= ~pair;
     }
-
-    return true;
 }
 
-// ============================================================================
-// Anti-Symmetry Rule (REAL algorithm from JavaScript)
-// ============================================================================
-
-bool HexukiBitboard::isBoardMirrored() const {
-    // If symmetry already broken, no need to check
-    if (!symmetryStillPossible) {
-        return false;
-    }
-
-    // Check if board is currently symmetric
+void HexukiBitboard::rebuildMirrorMismatch() {
+    mirrorMismatch = 0;
     for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
-        // Skip center column hexes (they mirror to themselves)
-        bool isCenterHex = false;
-        for (int i = 0; i < 5; i++) {
-            if (hexId == CENTER_COLUMN_HEXES[i]) {
-                isCenterHex = true;
-                break;
-            }
-        }
-        if (isCenterHex) continue;
-
-        int mirrorHexId = VERTICAL_MIRROR_PAIRS[hexId];
-        int val1 = hexValues[hexId];
-        int val2 = hexValues[mirrorHexId];
-
-        // If one is empty and the other isn't, not currently symmetric
-        if ((val1 == 0) != (val2 == 0)) {
-            return false;
-        }
-
-        // If both occupied but different values, not symmetric AND never will be
-        if (val1 != 0 && val2 != 0 && val1 != val2) {
-            // NOTE: We can't modify symmetryStillPossible here (const function)
-            // This will be handled in the non-const version
-            return false;
-        }
+        updateMirrorMismatch(hexId);
     }
-
-    return true;  // Board is currently symmetric
 }
 
 // ============================================================================
 // Move Validation (REAL rules from JavaScript)
 // ============================================================================
 
-bool HexukiBitboard::isMoveLegal(int hexId) const {
-    // Check if hex is empty
-    if (isHexOccupied(hexId)) {
-        return false;
+uint32_t HexukiBitboard::computeLegalHexMask() const {
+    if (hasFreeOpening(ruleFlags) && hexOccupied == startingOccupancy(ruleFlags)) {
+        return ALL_HEXES_MASK & ~hexOccupied;
     }
-
-    // Check if adjacent to an occupied hex
-    if (!hasAdjacentOccupied(hexId)) {
-        return false;
-    }
-
-    // Check chain length constraint
-    if (!checkChainLengthConstraint(hexId)) {
-        return false;
-    }
-
-    return true;
+    return (ruleFlags & RULE_CHAIN_CONSTRAINT) ? LegalMaskTable::computeLegalHexMask(hexOccupied)
+                                               : LegalMaskTable::computeAdjacentHexMask(hexOccupied);
 }
 
 bool HexukiBitboard::isValidMove(const Move& move) const {
     if (!move.isValid()) return false;
 
-    // Check if position is legal
-    if (!isMoveLegal(move.hexId)) {
+    // Check if position is legal (empty, adjacent, chain length rule)
+    if (!(getLegalHexMask() & (1u << move.hexId))) {
         return false;
     }
 
@@ -375,36 +176,24 @@ bool HexukiBitboard::isValidMove(const Move& move) const {
         return false;
     }
 
-    // Symmetry checks removed - no longer enforcing anti-symmetry rule
+    // Anti-symmetry rule (only when enabled)
+    if (createsMirroredBoard(move)) {
+        return false;
+    }
 
     return true;
 }
 
-std::vector<Move> HexukiBitboard::getValidMoves() const {
-    std::vector<Move> moves;
-    auto availableTiles = getAvailableTiles(currentPlayer);
-
-    // Get unique tile values (handle duplicates like [1,1,1,1,1,1,1,1,1])
-    // If tiles = [1,1,1], we only want to try placing "1" once, not three times
-    std::vector<int> uniqueTileValues = availableTiles;
-    std::sort(uniqueTileValues.begin(), uniqueTileValues.end());
-    uniqueTileValues.erase(std::unique(uniqueTileValues.begin(), uniqueTileValues.end()), uniqueTileValues.end());
-
-    // Symmetry checks removed - no longer enforcing anti-symmetry rule
-
-    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
-        if (isHexOccupied(hexId)) continue;
-
-        if (isMoveLegal(hexId)) {
-            // Try each unique tile value (avoids generating duplicate moves)
-            for (int tileValue : uniqueTileValues) {
-                // Add all valid moves without symmetry checks
-                moves.push_back(Move(hexId, tileValue));
-            }
-        }
-    }
+void HexukiBitboard::generateMoves(MoveList& moves) const {
+    // Legal hexes x unique tile values (duplicates like [1,1,1] yield "1" once),
+    // minus any move the anti-symmetry rule rejects
+    MoveGenerator(*this).fill(moves);
+}
 
-    return moves;
+std::vector<Move> HexukiBitboard::getValidMoves() const {
+    MoveList moves;
+    generateMoves(moves);
+    return std::vector<Move>(moves.begin(), moves.end());
 }
 
 // ============================================================================
@@ -415,46 +204,82 @@ void HexukiBitboard::makeMove(const Move& move) {
     // Place tile on board
     hexOccupied |= (1u << move.hexId);
     hexValues[move.hexId] = move.tileValue;
+    addToScores(move.hexId, move.tileValue);
 
-    // Remove tile from current player's available tiles
-    std::vector<int>& tiles = (currentPlayer == PLAYER_1) ? p1AvailableTiles : p2AvailableTiles;
-    auto it = std::find(tiles.begin(), tiles.end(), move.tileValue);
-    if (it != tiles.end()) {
-        tiles.erase(it);  // Remove first occurrence
+    // Remove tile from current player's available tiles (decrement its count)
+    uint64_t& tiles = (currentPlayer == PLAYER_1) ? p1Tiles : p2Tiles;
+    int shift = TILE_SLOTS[move.tileValue] * TILE_COUNT_BITS;
+    int count = static_cast<int>((tiles >> shift) & TILE_COUNT_MASK);
+    bool tookTile = count > 0;
+    if (tookTile) {
+        tiles -= 1ull << shift;
     }
 
-    // Update symmetry tracking (if we ever re-enable it)
-    if (symmetryStillPossible) {
-        int mirrorHexId = VERTICAL_MIRROR_PAIRS[move.hexId];
-        if (hexValues[mirrorHexId] != 0 && hexValues[mirrorHexId] != move.tileValue) {
-            symmetryStillPossible = false;
-        }
-    }
+    // Update symmetry tracking
+    updateMirrorMismatch(move.hexId);
+
+    // Record for unmakeMove()
+    assert(undoCount < MAX_PLIES);
+    undoStack[undoCount++] = UndoEntry{move, tookTile};
 
     // Update zobrist hash
-    updateZobristHash(move);
+    updateZobristHash(move, currentPlayer, count);
 
     // Switch to next player
     currentPlayer = (currentPlayer == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+
+#ifdef HEXUKI_VERIFY_SCORE
+    verifyIncrementalState();
+#endif
+#ifdef HEXUKI_VERIFY_HASH
+    verifyHashes();
+#endif
 }
 
-void HexukiBitboard::unmakeMove(const Move& move) {
+void HexukiBitboard::unmakeMove() {
+    assert(undoCount > 0);
+    const UndoEntry& entry = undoStack[--undoCount];
+    const Move move = entry.move;
+
     // Switch player back (undo the player switch from makeMove)
     currentPlayer = (currentPlayer == PLAYER_1) ? PLAYER_2 : PLAYER_1;
 
-    // Reverse zobrist hash update (XOR is self-inverse)
-    updateZobristHash(move);
+    // Add tile back to player's available tiles (only if makeMove took one)
+    int count = 0;
+    if (entry.tookTile) {
+        uint64_t& tiles = (currentPlayer == PLAYER_1) ? p1Tiles : p2Tiles;
+        int shift = TILE_SLOTS[move.tileValue] * TILE_COUNT_BITS;
+        tiles += 1ull << shift;
+        count = static_cast<int>((tiles >> shift) & TILE_COUNT_MASK);
+    }
 
-    // Add tile back to player's available tiles
-    std::vector<int>& tiles = (currentPlayer == PLAYER_1) ? p1AvailableTiles : p2AvailableTiles;
-    tiles.push_back(move.tileValue);
+    // Reverse zobrist hash update (XOR is self-inverse)
+    updateZobristHash(move, currentPlayer, count);
 
     // Clear tile from board
     hexOccupied &= ~(1u << move.hexId);
     hexValues[move.hexId] = 0;
+    removeFromScores(move.hexId, move.tileValue);
+    updateMirrorMismatch(move.hexId);
+
+#ifdef HEXUKI_VERIFY_SCORE
+    verifyIncrementalState();
+#endif
+#ifdef HEXUKI_VERIFY_HASH
+    verifyHashes();
+#endif
+}
 
-    // Note: symmetryStillPossible is not restored since symmetry checks are disabled
-    // If symmetry is re-enabled later, this would need to track the previous state
+void HexukiBitboard::unmakeMoves(int count) {
+    for (; count > 0 && undoCount > 0; count--) {
+        unmakeMove();
+    }
+}
+
+void HexukiBitboard::unmakeMove(const Move& move) {
+    assert(undoCount > 0 && undoStack[undoCount - 1].move == move);
+    (void)move;
+    unmakeMove();
 }
 
 // ============================================================================
@@ -482,13 +307,13 @@ int HexukiBitboard::calculatePlayerScore(int player) const {
     if (player == PLAYER_1) {
         // P1 chains: down-right diagonals
         for (int i = 0; i < P1_CHAIN_COUNT; i++) {
-            int chainScore = calculateChainScore(P1_CHAINS[i], P1_CHAIN_LENGTHS[i]);
+            int chainScore = calculateChainScore(P1_CHAINS[i].data(), P1_CHAIN_LENGTHS[i]);
             totalScore += chainScore;
         }
     } else {
         // P2 chains: down-left diagonals
         for (int i = 0; i < P2_CHAIN_COUNT; i++) {
-            int chainScore = calculateChainScore(P2_CHAINS[i], P2_CHAIN_LENGTHS[i]);
+            int chainScore = calculateChainScore(P2_CHAINS[i].data(), P2_CHAIN_LENGTHS[i]);
             totalScore += chainScore;
         }
     }
@@ -496,20 +321,93 @@ int HexukiBitboard::calculatePlayerScore(int player) const {
     return totalScore;
 }
 
-int HexukiBitboard::getScore(int player) const {
-    return calculatePlayerScore(player);
+void HexukiBitboard::addToScores(int hexId, int tileValue) {
+    // A hex lies on one chain of each player: scale that chain, adjust the total
+    for (int p = 0; p < 2; p++) {
+        int32_t& product = chainProducts[p][HEX_SCORING_CHAINS[hexId][p]];
+        playerScores[p] += product * (tileValue - 1);
+        product *= tileValue;
+    }
+}
+
+void HexukiBitboard::removeFromScores(int hexId, int tileValue) {
+    for (int p = 0; p < 2; p++) {
+        int32_t& product = chainProducts[p][HEX_SCORING_CHAINS[hexId][p]];
+        product /= tileValue;  // Exact: tileValue is one of the product's factors
+        playerScores[p] -= product * (tileValue - 1);
+    }
+}
+
+void HexukiBitboard::rebuildScores() {
+    for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+        chainProducts[0][c] = calculateChainScore(P1_CHAINS[c].data(), P1_CHAIN_LENGTHS[c]);
+        chainProducts[1][c] = calculateChainScore(P2_CHAINS[c].data(), P2_CHAIN_LENGTHS[c]);
+    }
+    playerScores[0] = calculatePlayerScore(PLAYER_1);
+    playerScores[1] = calculatePlayerScore(PLAYER_2);
+}
+
+void HexukiBitboard::verifyIncrementalState() const {
+    for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+        if (chainProducts[0][c] != calculateChainScore(P1_CHAINS[c].data(), P1_CHAIN_LENGTHS[c]) ||
+            chainProducts[1][c] != calculateChainScore(P2_CHAINS[c].data(), P2_CHAIN_LENGTHS[c])) {
+            std::cerr << "HEXUKI_VERIFY_SCORE: chain " << c << " product mismatch at " << savePosition() << std::endl;
+            std::abort();
+        }
+    }
+    if (playerScores[0] != calculatePlayerScore(PLAYER_1) || playerScores[1] != calculatePlayerScore(PLAYER_2)) {
+        std::cerr << "HEXUKI_VERIFY_SCORE: score total mismatch at " << savePosition() << std::endl;
+        std::abort();
+    }
+
+    HexukiBitboard rebuilt = *this;
+    rebuilt.rebuildMirrorMismatch();
+    if (mirrorMismatch != rebuilt.mirrorMismatch) {
+        std::cerr << "HEXUKI_VERIFY_SCORE: mirror signature mismatch at " << savePosition() << std::endl;
+        std::abort();
+    }
 }
 
 // ============================================================================
 // Zobrist Hashing
 // ============================================================================
 
-void HexukiBitboard::updateZobristHash(const Move& move) {
-    // XOR in the hash for this tile placement
-    zobristHash ^= Zobrist::getTileHash(move.hexId, move.tileValue);
+void HexukiBitboard::updateZobristHash(const Move& move, int mover, int count) {
+    // Side to move flips: XOR out one player key and XOR in the other
+    // (the same pair for every symmetry, swapped or not)
+    const uint64_t sideToggle = Zobrist::getPlayerHash(PLAYER_1) ^ Zobrist::getPlayerHash(PLAYER_2);
+
+    // Mover's count of the value drops by one (key 0 when count is 0: no tile taken),
+    // under the other player's keys for symmetries that swap players
+    const uint64_t take[2] = {
+        Zobrist::getTileTakeHash(mover, move.tileValue, count),
+        Zobrist::getTileTakeHash(PLAYER_1 + PLAYER_2 - mover, move.tileValue, count),
+    };
+
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        // XOR in the hash for this tile placement (at its transformed hex)
+        zobristHashes[s] ^= Zobrist::getTileHash(SYMMETRY_HEX_MAP[s][move.hexId], move.tileValue)
+                          ^ sideToggle ^ take[SYMMETRY_SWAPS_PLAYERS[s]];
+    }
+}
+
+void HexukiBitboard::rebuildHashes() {
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        zobristHashes[s] = Zobrist::hash(*this, s);
+    }
+}
+
+uint64_t HexukiBitboard::getHashHigh(int symmetry) const {
+    return Zobrist::hashHigh(*this, symmetry);
+}
 
-    // XOR in player-to-move hash
-    zobristHash ^= Zobrist::getPlayerHash(currentPlayer);
+void HexukiBitboard::verifyHashes() const {
+    for (int s = 0; s < NUM_SYMMETRIES; s++) {
+        if (zobristHashes[s] != Zobrist::hash(*this, s)) {
+            std::cerr << "HEXUKI_VERIFY_HASH: symmetry " << s << " hash mismatch at " << savePosition() << std::endl;
+            std::abort();
+        }
+    }
 }
 
 // ============================================================================
@@ -518,10 +416,7 @@ void HexukiBitboard::updateZobristHash(const Move& move) {
 
 void HexukiBitboard::print() const {
     // Count occupied hexes for move count
-    int occupiedCount = 0;
-    for (int i = 0; i < NUM_HEXES; i++) {
-        if (isHexOccupied(i)) occupiedCount++;
-    }
+    int occupiedCount = BitOps::popcount(hexOccupied);
 
     std::cout << "=== Hexuki Board State ===" << std::endl;
     std::cout << "Occupied: " << occupiedCount << "/" << NUM_HEXES << ", Player: P" << currentPlayer << std::endl;
@@ -560,9 +455,27 @@ void HexukiBitboard::print() const {
 }
 
 std::string HexukiBitboard::toNotation() const {
-    // Note: Move history is no longer tracked for performance reasons
-    // This function returns empty string. Use savePosition() for current state.
-    return "";
+    // Starting position: undo the whole history
+    HexukiBitboard start = *this;
+    start.unmakeMoves(undoCount);
+
+    HexukiBitboard standard = start;
+    standard.reset();
+
+    std::string notation;
+    if (start.pack() != standard.pack()) {
+        notation = start.savePosition();
+    }
+
+    for (int ply = 0; ply < undoCount; ply++) {
+        if (!notation.empty()) notation += ' ';
+        notation += undoStack[ply].move.toString();
+    }
+    return notation;
+}
+
+bool HexukiBitboard::fromNotation(std::string_view notation) {
+    return parseGame(notation, *this).ok();
 }
 
 // ============================================================================
@@ -575,9 +488,12 @@ void HexukiBitboard::setHexValue(int hexId, int tileValue) {
     // Place the tile
     hexOccupied |= (1u << hexId);
     hexValues[hexId] = tileValue;
+    rebuildScores();
+    rebuildMirrorMismatch();
+    undoCount = 0;  // Setup edits aren't undoable moves
 
     // Recalculate hash
-    zobristHash = Zobrist::hash(*this);
+    rebuildHashes();
 }
 
 void HexukiBitboard::removeHexValue(int hexId) {
@@ -586,119 +502,96 @@ void HexukiBitboard::removeHexValue(int hexId) {
     // Remove the tile
     hexOccupied &= ~(1u << hexId);
     hexValues[hexId] = 0;
+    rebuildScores();
+    rebuildMirrorMismatch();
+    undoCount = 0;
 
     // Recalculate hash
-    zobristHash = Zobrist::hash(*this);
+    rebuildHashes();
 }
 
 void HexukiBitboard::setAvailableTiles(int player, const std::vector<int>& tiles) {
-    // Directly assign tile vector (supports duplicates like [1,1,1,1,1,1,1,1,1])
+    // Count each value (supports duplicates like [1,1,1,1,1,1,1,1,1])
+    // Values that aren't in TILE_VALUES can never be played and are dropped
+    uint64_t inventory = 0;
+    for (int tileValue : tiles) {
+        if (tileValue < 1 || tileValue > MAX_TILE_VALUE || TILE_SLOTS[tileValue] < 0) continue;
+        uint64_t unit = 1ull << (TILE_SLOTS[tileValue] * TILE_COUNT_BITS);
+        if (((inventory / unit) & TILE_COUNT_MASK) < TILE_COUNT_MASK) {
+            inventory += unit;
+        }
+    }
+
+    setTileInventory(player, inventory);
+}
+
+void HexukiBitboard::setTileInventory(int player, uint64_t inventory) {
     if (player == PLAYER_1) {
-        p1AvailableTiles = tiles;
+        p1Tiles = inventory;
     } else if (player == PLAYER_2) {
-        p2AvailableTiles = tiles;
+        p2Tiles = inventory;
     }
+
+    tilesAreIdentical = (p1Tiles == p2Tiles);
+    rebuildHashes();
+}
+
+void HexukiBitboard::setCurrentPlayer(int player) {
+    currentPlayer = player;
+    rebuildHashes();
 }
 
 void HexukiBitboard::clearBoard() {
     // Clear all tiles but keep player and move count
     hexOccupied = 0;
     std::memset(hexValues, 0, sizeof(hexValues));
-    zobristHash = Zobrist::hash(*this);
+    rebuildScores();
+    rebuildMirrorMismatch();
+    undoCount = 0;
+    rebuildHashes();
 }
 
-void HexukiBitboard::loadPosition(const std::string& position) {
-    // Clear everything first
-    clearBoard();
-    p1AvailableTiles = {1, 2, 3, 4, 5, 6, 7, 8, 9};  // Default: all tiles 1-9 available
-    p2AvailableTiles = {1, 2, 3, 4, 5, 6, 7, 8, 9};
-    currentPlayer = PLAYER_1;
-
-    // Parse format: "h0:1,h4:5,h9:1|p1:2,3,4|p2:6,7,8|turn:1"
-    std::istringstream iss(position);
-    std::string section;
-
-    bool p1Specified = false;
-    bool p2Specified = false;
-
-    while (std::getline(iss, section, '|')) {
-        if (section.empty()) continue;
-
-        // Parse hex placements: h0:1,h4:5
-        if (section[0] == 'h') {
-            std::istringstream hexStream(section);
-            std::string hexPair;
-            while (std::getline(hexStream, hexPair, ',')) {
-                if (hexPair.size() < 4) continue;
-
-                // Parse "h6:5" → hex 6, tile 5
-                size_t colonPos = hexPair.find(':');
-                if (colonPos == std::string::npos) continue;
-
-                int hexId = std::stoi(hexPair.substr(1, colonPos - 1));
-                int tileVal = std::stoi(hexPair.substr(colonPos + 1));
-
-                setHexValue(hexId, tileVal);
-            }
-        }
-        // Parse player 1 tiles: p1:2,3,4
-        else if (section.substr(0, 3) == "p1:") {
-            p1Specified = true;
-            std::istringstream tileStream(section.substr(3));
-            std::vector<int> tiles;
-            std::string tileStr;
-            while (std::getline(tileStream, tileStr, ',')) {
-                tiles.push_back(std::stoi(tileStr));
-            }
-            setAvailableTiles(PLAYER_1, tiles);
-        }
-        // Parse player 2 tiles: p2:6,7,8
-        else if (section.substr(0, 3) == "p2:") {
-            p2Specified = true;
-            std::istringstream tileStream(section.substr(3));
-            std::vector<int> tiles;
-            std::string tileStr;
-            while (std::getline(tileStream, tileStr, ',')) {
-                tiles.push_back(std::stoi(tileStr));
-            }
-            setAvailableTiles(PLAYER_2, tiles);
-        }
-        // Parse turn: turn:1
-        else if (section.substr(0, 5) == "turn:") {
-            currentPlayer = std::stoi(section.substr(5));
-        }
+bool HexukiBitboard::loadPosition(std::string_view position) {
+    // Parse into the packed form, then set up the board in one go (hashes computed once)
+    PackedPosition packed;
+    if (!parsePosition(position, packed, ruleFlags).ok()) {
+        return false;
     }
+    unpack(packed);
+    return true;
+}
 
-    // Recalculate symmetryStillPossible based on current board state
-    // Symmetry is impossible if any mirror pair has different values
-    symmetryStillPossible = true;
+PackedPosition HexukiBitboard::pack() const {
+    PackedPosition position;
     for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
-        // Skip center column hexes (they mirror to themselves)
-        bool isCenterHex = false;
-        for (int i = 0; i < 5; i++) {
-            if (hexId == CENTER_COLUMN_HEXES[i]) {
-                isCenterHex = true;
-                break;
-            }
-        }
-        if (isCenterHex) continue;
-
-        int mirrorHexId = VERTICAL_MIRROR_PAIRS[hexId];
-        int val1 = hexValues[hexId];
-        int val2 = hexValues[mirrorHexId];
-
-        // If both occupied but different values, symmetry is impossible
-        if (val1 != 0 && val2 != 0 && val1 != val2) {
-            symmetryStillPossible = false;
-            break;
-        }
+        if (hexValues[hexId] == 0) continue;
+        assert(hexValues[hexId] <= MAX_TILE_VALUE && TILE_SLOTS[hexValues[hexId]] >= 0);
+        position.setCell(hexId, TILE_SLOTS[hexValues[hexId]] + 1);
     }
+    position.setInventory(PLAYER_1, p1Tiles);
+    position.setInventory(PLAYER_2, p2Tiles);
+    position.setCurrentPlayer(currentPlayer);
+    position.setRuleFlags(ruleFlags);
+    return position;
+}
 
-    // Check if both players have identical starting tiles
-    tilesAreIdentical = tilesMatch(p1AvailableTiles, p2AvailableTiles);
-
-    // Recalculate hash
-    zobristHash = Zobrist::hash(*this);
+void HexukiBitboard::unpack(const PackedPosition& position) {
+    hexOccupied = 0;
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        int cell = position.getCell(hexId);
+        if (cell > NUM_TILES_PER_PLAYER) cell = 0;  // Never produced by pack()
+        hexValues[hexId] = cell ? static_cast<uint8_t>(TILE_VALUES[cell - 1]) : 0;
+        if (cell) hexOccupied |= (1u << hexId);
+    }
+    p1Tiles = position.getInventory(PLAYER_1);
+    p2Tiles = position.getInventory(PLAYER_2);
+    currentPlayer = position.getCurrentPlayer();
+    undoCount = 0;
+
+    rebuildScores();
+    rebuildMirrorMismatch();
+    tilesAreIdentical = (p1Tiles == p2Tiles);
+    setRuleFlags(position.getRuleFlags());  // Also rebuilds the hashes
 }
 
 std::string HexukiBitboard::savePosition() const {
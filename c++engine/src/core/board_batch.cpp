@@ -0,0 +1,320 @@
+#include "core/board_batch.h"
+#include "core/legal_mask_table.h"
+#include "utils/timer.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace hexuki {
+
+namespace {
+
+// Tile values by slot as 32-bit entries (gather source)
+alignas(32) const int32_t TILE_VALUE_TABLE[NUM_TILES_PER_PLAYER] = {
+    TILE_VALUES[0], TILE_VALUES[1], TILE_VALUES[2], TILE_VALUES[3], TILE_VALUES[4],
+    TILE_VALUES[5], TILE_VALUES[6], TILE_VALUES[7], TILE_VALUES[8]
+};
+
+inline uint32_t xorshift32(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Map a 32-bit random number onto [0, n) (multiply-high, no division)
+inline uint32_t scaleRandom(uint32_t random, uint32_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(random) * n) >> 32);
+}
+
+// Lowest set bit of value after dropping the n lowest ones
+inline uint32_t selectLowBit(uint32_t value, uint32_t n) {
+    for (; n > 0; n--) value &= value - 1;
+    return value & (0u - value);
+}
+
+inline uint32_t seedLane(uint32_t seed, int lane) {
+    // splitmix32-style mixing so neighbouring lanes get unrelated streams
+    uint32_t z = seed + 0x9E3779B9u * static_cast<uint32_t>(lane + 1);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    z ^= z >> 16;
+    return z ? z : 0x6D2B79F5u;  // xorshift state must be nonzero
+}
+
+#ifdef __AVX2__
+
+inline __m256i xorshift32(__m256i& state) {
+    state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 13));
+    state = _mm256_xor_si256(state, _mm256_srli_epi32(state, 17));
+    state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 5));
+    return state;
+}
+
+inline __m256i scaleRandom(__m256i random, __m256i n) {
+    // High halves of the 32x32 products: even lanes, then odd lanes
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(random, n), 32);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(random, 32), _mm256_srli_epi64(n, 32));
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+inline __m256i popcount32(__m256i v) {
+    v = _mm256_sub_epi32(v, _mm256_and_si256(_mm256_srli_epi32(v, 1), _mm256_set1_epi32(0x55555555)));
+    v = _mm256_add_epi32(_mm256_and_si256(v, _mm256_set1_epi32(0x33333333)),
+                         _mm256_and_si256(_mm256_srli_epi32(v, 2), _mm256_set1_epi32(0x33333333)));
+    v = _mm256_and_si256(_mm256_add_epi32(v, _mm256_srli_epi32(v, 4)), _mm256_set1_epi32(0x0F0F0F0F));
+    return _mm256_srli_epi32(_mm256_mullo_epi32(v, _mm256_set1_epi32(0x01010101)), 24);
+}
+
+inline __m256i selectLowBit(__m256i value, __m256i n) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    while (true) {
+        __m256i pending = _mm256_cmpgt_epi32(n, zero);
+        if (_mm256_testz_si256(pending, pending)) break;
+        __m256i cleared = _mm256_and_si256(value, _mm256_sub_epi32(value, one));
+        value = _mm256_blendv_epi8(value, cleared, pending);
+        n = _mm256_add_epi32(n, pending);  // pending lanes are -1
+    }
+    return _mm256_and_si256(value, _mm256_sub_epi32(zero, value));
+}
+
+// Index of a single set bit (exact via the float exponent; 0 maps to -127)
+inline __m256i bitIndex(__m256i bit) {
+    __m256i exponent = _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(bit)), 23);
+    return _mm256_sub_epi32(exponent, _mm256_set1_epi32(127));
+}
+
+#endif // __AVX2__
+
+} // namespace
+
+template <int Width>
+BoardBatch<Width>::BoardBatch()
+    : occupied{}
+    , values{}
+    , counts{}
+    , rngState{}
+    , live{}
+    , currentPlayer(PLAYER_1) {}
+
+template <int Width>
+void BoardBatch<Width>::load(const HexukiBitboard& board, uint32_t seed) {
+    for (int lane = 0; lane < Width; lane++) {
+        occupied[lane] = board.getOccupiedMask();
+        rngState[lane] = seedLane(seed, lane);
+        live[lane] = ~0u;
+    }
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        uint32_t value = static_cast<uint32_t>(board.getTileValue(hexId));
+        for (int lane = 0; lane < Width; lane++) values[hexId][lane] = value;
+    }
+    for (int p = 0; p < 2; p++) {
+        for (int slot = 0; slot < NUM_TILES_PER_PLAYER; slot++) {
+            uint32_t count = static_cast<uint32_t>(board.getTileCount(p + 1, TILE_VALUES[slot]));
+            for (int lane = 0; lane < Width; lane++) counts[p][slot][lane] = count;
+        }
+    }
+    currentPlayer = board.getCurrentPlayer();
+}
+
+template <int Width>
+bool BoardBatch<Width>::step() {
+#ifdef __AVX2__
+    return stepSimd();
+#else
+    return stepScalar();
+#endif
+}
+
+template <int Width>
+bool BoardBatch<Width>::hasSimdKernel() {
+#ifdef __AVX2__
+    return true;
+#else
+    return false;
+#endif
+}
+
+template <int Width>
+bool BoardBatch<Width>::stepScalar() {
+    const uint32_t* legalTable = LegalMaskTable::data();
+    uint32_t (&tiles)[NUM_TILES_PER_PLAYER][Width] = counts[currentPlayer - 1];
+    bool moved = false;
+
+    for (int lane = 0; lane < Width; lane++) {
+        uint32_t legal = legalTable[occupied[lane]];
+        uint32_t present = 0;
+        for (int slot = 0; slot < NUM_TILES_PER_PLAYER; slot++) {
+            present |= static_cast<uint32_t>(tiles[slot][lane] != 0) << slot;
+        }
+
+        // Both draws happen every ply so the streams match the SIMD kernel
+        uint32_t hexRandom = xorshift32(rngState[lane]);
+        uint32_t tileRandom = xorshift32(rngState[lane]);
+
+        uint32_t hexCount = static_cast<uint32_t>(BitOps::popcount(legal));
+        uint32_t tileCount = static_cast<uint32_t>(BitOps::popcount(present));
+        if (!live[lane]) continue;
+        if (hexCount == 0 || tileCount == 0) {
+            live[lane] = 0;  // Side to move is stuck: game over for this lane
+            continue;
+        }
+
+        uint32_t hexBit = selectLowBit(legal, scaleRandom(hexRandom, hexCount));
+        uint32_t tileBit = selectLowBit(present, scaleRandom(tileRandom, tileCount));
+        int hexId = BitOps::countTrailingZeros(hexBit);
+        int slot = BitOps::countTrailingZeros(tileBit);
+
+        occupied[lane] |= hexBit;
+        values[hexId][lane] = static_cast<uint32_t>(TILE_VALUES[slot]);
+        tiles[slot][lane]--;
+        moved = true;
+    }
+
+    currentPlayer = (currentPlayer == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+    return moved;
+}
+
+template <int Width>
+bool BoardBatch<Width>::stepSimd() {
+#ifdef __AVX2__
+    const int* legalTable = reinterpret_cast<const int*>(LegalMaskTable::data());
+    uint32_t (&tiles)[NUM_TILES_PER_PLAYER][Width] = counts[currentPlayer - 1];
+    const __m256i zero = _mm256_setzero_si256();
+    int moved = 0;
+
+    for (int base = 0; base < Width; base += 8) {
+        __m256i occ = _mm256_load_si256(reinterpret_cast<const __m256i*>(occupied + base));
+        __m256i legal = _mm256_i32gather_epi32(legalTable, occ, 4);
+
+        __m256i present = zero;
+        for (int slot = 0; slot < NUM_TILES_PER_PLAYER; slot++) {
+            __m256i count = _mm256_load_si256(reinterpret_cast<const __m256i*>(tiles[slot] + base));
+            __m256i empty = _mm256_cmpeq_epi32(count, zero);
+            present = _mm256_or_si256(present, _mm256_andnot_si256(empty, _mm256_set1_epi32(1 << slot)));
+        }
+
+        __m256i state = _mm256_load_si256(reinterpret_cast<const __m256i*>(rngState + base));
+        __m256i hexRandom = xorshift32(state);
+        __m256i tileRandom = xorshift32(state);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(rngState + base), state);
+
+        __m256i hexCount = popcount32(legal);
+        __m256i tileCount = popcount32(present);
+        __m256i* alive = reinterpret_cast<__m256i*>(live + base);
+        __m256i active = _mm256_and_si256(_mm256_cmpgt_epi32(hexCount, zero), _mm256_cmpgt_epi32(tileCount, zero));
+        active = _mm256_and_si256(active, _mm256_load_si256(alive));
+        _mm256_store_si256(alive, active);
+        moved |= _mm256_movemask_epi8(active);
+
+        __m256i hexBit = _mm256_and_si256(selectLowBit(legal, scaleRandom(hexRandom, hexCount)), active);
+        __m256i tileBit = _mm256_and_si256(selectLowBit(present, scaleRandom(tileRandom, tileCount)), active);
+
+        // Inactive lanes have no bits set, so the blends below leave them alone
+        __m256i slotIndex = _mm256_max_epi32(bitIndex(tileBit), zero);
+        __m256i tileValue = _mm256_i32gather_epi32(TILE_VALUE_TABLE, slotIndex, 4);
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(occupied + base), _mm256_or_si256(occ, hexBit));
+
+        for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+            __m256i bit = _mm256_set1_epi32(1 << hexId);
+            __m256i placed = _mm256_cmpeq_epi32(_mm256_and_si256(hexBit, bit), bit);
+            __m256i* cell = reinterpret_cast<__m256i*>(values[hexId] + base);
+            _mm256_store_si256(cell, _mm256_blendv_epi8(_mm256_load_si256(cell), tileValue, placed));
+        }
+
+        for (int slot = 0; slot < NUM_TILES_PER_PLAYER; slot++) {
+            __m256i bit = _mm256_set1_epi32(1 << slot);
+            __m256i used = _mm256_cmpeq_epi32(_mm256_and_si256(tileBit, bit), bit);
+            __m256i* count = reinterpret_cast<__m256i*>(tiles[slot] + base);
+            _mm256_store_si256(count, _mm256_add_epi32(_mm256_load_si256(count), used));  // used = -1
+        }
+    }
+
+    currentPlayer = (currentPlayer == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+    return moved != 0;
+#else
+    return stepScalar();
+#endif
+}
+
+template <int Width>
+int BoardBatch<Width>::playout() {
+    int plies = 0;
+    while (step()) plies++;
+    return plies;
+}
+
+template <int Width>
+int BoardBatch<Width>::playoutScalar() {
+    int plies = 0;
+    while (stepScalar()) plies++;
+    return plies;
+}
+
+template <int Width>
+void BoardBatch<Width>::computeScores(int32_t p1Scores[Width], int32_t p2Scores[Width]) const {
+#ifdef __AVX2__
+    const __m256i one = _mm256_set1_epi32(1);
+    for (int base = 0; base < Width; base += 8) {
+        __m256i totals[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+        for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+            __m256i products[2] = {one, one};
+            for (int i = 0; i < MAX_LINE_LENGTH; i++) {
+                int p1Hex = P1_CHAINS[c][i];
+                int p2Hex = P2_CHAINS[c][i];
+                if (p1Hex >= 0) {
+                    __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(values[p1Hex] + base));
+                    products[0] = _mm256_mullo_epi32(products[0], _mm256_max_epi32(v, one));  // Empty counts as 1
+                }
+                if (p2Hex >= 0) {
+                    __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(values[p2Hex] + base));
+                    products[1] = _mm256_mullo_epi32(products[1], _mm256_max_epi32(v, one));
+                }
+            }
+            totals[0] = _mm256_add_epi32(totals[0], products[0]);
+            totals[1] = _mm256_add_epi32(totals[1], products[1]);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p1Scores + base), totals[0]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p2Scores + base), totals[1]);
+    }
+#else
+    for (int lane = 0; lane < Width; lane++) {
+        int32_t totals[2] = {0, 0};
+        for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+            int32_t products[2] = {1, 1};
+            for (int i = 0; i < MAX_LINE_LENGTH; i++) {
+                if (P1_CHAINS[c][i] >= 0 && values[P1_CHAINS[c][i]][lane]) products[0] *= values[P1_CHAINS[c][i]][lane];
+                if (P2_CHAINS[c][i] >= 0 && values[P2_CHAINS[c][i]][lane]) products[1] *= values[P2_CHAINS[c][i]][lane];
+            }
+            totals[0] += products[0];
+            totals[1] += products[1];
+        }
+        p1Scores[lane] = totals[0];
+        p2Scores[lane] = totals[1];
+    }
+#endif
+}
+
+template <int Width>
+double BoardBatch<Width>::evaluateTerminal(double results[Width], int lanes) const {
+    alignas(32) int32_t p1Scores[Width];
+    alignas(32) int32_t p2Scores[Width];
+    computeScores(p1Scores, p2Scores);
+
+    double total = 0.0;
+    for (int lane = 0; lane < Width; lane++) {
+        double result = (p1Scores[lane] > p2Scores[lane]) ? 1.0 : (p1Scores[lane] < p2Scores[lane]) ? 0.0 : 0.5;
+        if (results) results[lane] = result;
+        if (lane < lanes) total += result;
+    }
+    return total;
+}
+
+template class BoardBatch<8>;
+template class BoardBatch<16>;
+template class BoardBatch<32>;
+
+} // namespace hexuki
@@ -0,0 +1,350 @@
+#include "core/hex_board.h"
+#include "core/zobrist.h"
+#include "utils/timer.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace hexuki {
+
+namespace {
+
+// Mask helpers that work for uint32_t and uint64_t masks alike
+template <typename Mask>
+int lowestBit(Mask mask) {
+    return BitOps::countTrailingZeros64(static_cast<uint64_t>(mask));
+}
+
+template <typename Mask>
+int countBits(Mask mask) {
+    return BitOps::popcount64(static_cast<uint64_t>(mask));
+}
+
+// Lengths of the occupied runs just below and just above position pos of a line pattern
+int runBelow(uint32_t pattern, int pos) {
+    int length = 0;
+    while (pos - length > 0 && (pattern & (1u << (pos - length - 1)))) length++;
+    return length;
+}
+
+int runAbove(uint32_t pattern, int pos) {
+    return BitOps::countTrailingZeros(~(pattern >> (pos + 1)));
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor & Reset
+// ============================================================================
+
+template <int Radius>
+HexBoard<Radius>::HexBoard(uint8_t flags)
+    : hexOccupied(0)
+    , hexValues{}
+    , tiles{}
+    , currentPlayer(PLAYER_1)
+    , ruleFlags(flags & ALL_RULE_FLAGS)
+    , mirrorMismatch(0)
+    , linePatterns{}
+    , runCounts{}
+    , chainProducts{}
+    , playerScores{}
+    , zobristHash(0)
+    , undoStack{}
+    , undoCount(0)
+{
+    reset();
+}
+
+template <int Radius>
+void HexBoard<Radius>::reset() {
+    hexOccupied = 0;
+    std::memset(hexValues, 0, sizeof(hexValues));
+    std::memset(linePatterns, 0, sizeof(linePatterns));
+    std::memset(runCounts, 0, sizeof(runCounts));
+    mirrorMismatch = 0;
+    undoCount = 0;
+
+    // Empty chains multiply to 1
+    for (int p = 0; p < 2; p++) {
+        for (int c = 0; c < Geometry::CHAINS_PER_PLAYER; c++) chainProducts[p][c] = 1;
+        playerScores[p] = Geometry::CHAINS_PER_PLAYER;
+    }
+
+    tiles[0] = tiles[1] = FULL_TILE_INVENTORY * TILES_PER_VALUE;
+    currentPlayer = PLAYER_1;
+
+    if (ruleFlags & RULE_CENTER_START) {
+        place(CENTER_HEX, STARTING_TILE);
+    }
+
+    zobristHash = computeHash();
+}
+
+template <int Radius>
+int HexBoard<Radius>::getTileCount(int player, int tileValue) const {
+    if (tileValue < 1 || tileValue > MAX_TILE_VALUE || TILE_SLOTS[tileValue] < 0) return 0;
+    return static_cast<int>((tiles[player - 1] >> (TILE_SLOTS[tileValue] * TILE_COUNT_BITS)) & TILE_COUNT_MASK);
+}
+
+// ============================================================================
+// Move Validation
+// ============================================================================
+
+template <int Radius>
+bool HexBoard<Radius>::allowsPlacement(int hexId) const {
+    // Runs through hexId exist only on its 3 lines: merge the runs on either
+    // side of it and see what that does to the run histogram
+    int delta[MAX_LINE_LENGTH + 1] = {};
+    int longestAffected = 0;
+
+    for (int axis = 0; axis < 3; axis++) {
+        uint32_t pattern = linePatterns[Geometry::HEX_LINES[hexId][axis]];
+        int pos = Geometry::HEX_LINE_POSITIONS[hexId][axis];
+        int below = runBelow(pattern, pos);
+        int above = runAbove(pattern, pos);
+
+        if (below) delta[below]--;
+        if (above) delta[above]--;
+        delta[below + above + 1]++;
+        longestAffected = std::max(longestAffected, below + above + 1);
+    }
+
+    // Second longest run on the board after the placement
+    int secondLongest = 0;
+    int found = 0;
+    for (int length = MAX_LINE_LENGTH; length >= 1; length--) {
+        found += runCounts[length] + delta[length];
+        if (found >= 2) {
+            secondLongest = length;
+            break;
+        }
+    }
+
+    return longestAffected <= secondLongest + 1;
+}
+
+template <int Radius>
+typename HexBoard<Radius>::Mask HexBoard<Radius>::getLegalHexMask() const {
+    Mask start = (ruleFlags & RULE_CENTER_START) ? (Mask(1) << CENTER_HEX) : Mask(0);
+    if (hasFreeOpening(ruleFlags) && hexOccupied == start) {
+        return Geometry::ALL_HEXES_MASK & ~hexOccupied;
+    }
+
+    // Candidate hexes: empty and adjacent to at least one occupied hex
+    Mask adjacent = 0;
+    for (Mask occ = hexOccupied; occ; occ &= occ - 1) {
+        adjacent |= Geometry::NEIGHBOR_MASKS[lowestBit(occ)];
+    }
+    adjacent &= ~hexOccupied;
+    if (!(ruleFlags & RULE_CHAIN_CONSTRAINT)) return adjacent;
+
+    Mask legal = 0;
+    for (Mask candidates = adjacent; candidates; candidates &= candidates - 1) {
+        int hexId = lowestBit(candidates);
+        if (allowsPlacement(hexId)) legal |= Mask(1) << hexId;
+    }
+    return legal;
+}
+
+template <int Radius>
+bool HexBoard<Radius>::isAntiSymmetryActive() const {
+    // Both hands are dealt the same tiles, so only the ply matters
+    return (ruleFlags & RULE_ANTI_SYMMETRY) && countBits(hexOccupied) >= 2;
+}
+
+template <int Radius>
+bool HexBoard<Radius>::createsMirroredBoard(const Move& move) const {
+    if (!isAntiSymmetryActive()) return false;
+
+    int mirrorHexId = Geometry::VERTICAL_MIRROR_PAIRS[move.hexId];
+    if (mirrorHexId == move.hexId) {
+        return mirrorMismatch == 0;
+    }
+
+    Mask pair = (Mask(1) << move.hexId) | (Mask(1) << mirrorHexId);
+    return mirrorMismatch == pair && hexValues[mirrorHexId] == move.tileValue;
+}
+
+template <int Radius>
+bool HexBoard<Radius>::isValidMove(const Move& move) const {
+    if (move.hexId < 0 || move.hexId >= NUM_HEXES) return false;
+    if (!(getLegalHexMask() & (Mask(1) << move.hexId))) return false;
+    if (getTileCount(currentPlayer, move.tileValue) == 0) return false;
+    return !createsMirroredBoard(move);
+}
+
+template <int Radius>
+int HexBoard<Radius>::generateMoves(Move* moves) const {
+    // Hex-major, TILE_VALUES order (same order as HexukiBitboard::generateMoves)
+    uint64_t present = tilePresence(tiles[currentPlayer - 1]);
+    if (!present) return 0;
+
+    bool antiSymmetry = isAntiSymmetryActive();
+    int count = 0;
+    for (Mask legal = getLegalHexMask(); legal; legal &= legal - 1) {
+        int hexId = lowestBit(legal);
+        for (uint64_t held = present; held; held &= held - 1) {
+            Move move(hexId, TILE_VALUES[BitOps::countTrailingZeros64(held) / TILE_COUNT_BITS]);
+            if (antiSymmetry && createsMirroredBoard(move)) continue;
+            moves[count++] = move;
+        }
+    }
+    return count;
+}
+
+template <int Radius>
+std::vector<Move> HexBoard<Radius>::getValidMoves() const {
+    Move moves[MAX_MOVES];
+    int count = generateMoves(moves);
+    return std::vector<Move>(moves, moves + count);
+}
+
+// ============================================================================
+// Move Execution
+// ============================================================================
+
+template <int Radius>
+void HexBoard<Radius>::place(int hexId, int tileValue) {
+    hexOccupied |= Mask(1) << hexId;
+    hexValues[hexId] = static_cast<uint8_t>(tileValue);
+
+    // A hex lies on one chain of each player: scale that chain, adjust the total
+    for (int p = 0; p < 2; p++) {
+        int64_t& product = chainProducts[p][Geometry::HEX_CHAINS[hexId][p]];
+        playerScores[p] += product * (tileValue - 1);
+        product *= tileValue;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        uint16_t& pattern = linePatterns[Geometry::HEX_LINES[hexId][axis]];
+        int pos = Geometry::HEX_LINE_POSITIONS[hexId][axis];
+        int below = runBelow(pattern, pos);
+        int above = runAbove(pattern, pos);
+        if (below) runCounts[below]--;
+        if (above) runCounts[above]--;
+        runCounts[below + above + 1]++;
+        pattern = static_cast<uint16_t>(pattern | (1u << pos));
+    }
+
+    updateMirrorMismatch(hexId);
+}
+
+template <int Radius>
+void HexBoard<Radius>::remove(int hexId, int tileValue) {
+    hexOccupied &= ~(Mask(1) << hexId);
+    hexValues[hexId] = 0;
+
+    for (int p = 0; p < 2; p++) {
+        int64_t& product = chainProducts[p][Geometry::HEX_CHAINS[hexId][p]];
+        product /= tileValue;  // Exact: tileValue is one of the product's factors
+        playerScores[p] -= product * (tileValue - 1);
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        uint16_t& pattern = linePatterns[Geometry::HEX_LINES[hexId][axis]];
+        int pos = Geometry::HEX_LINE_POSITIONS[hexId][axis];
+        pattern = static_cast<uint16_t>(pattern & ~(1u << pos));
+        int below = runBelow(pattern, pos);
+        int above = runAbove(pattern, pos);
+        runCounts[below + above + 1]--;
+        if (below) runCounts[below]++;
+        if (above) runCounts[above]++;
+    }
+
+    updateMirrorMismatch(hexId);
+}
+
+template <int Radius>
+void HexBoard<Radius>::updateMirrorMismatch(int hexId) {
+    int mirrorHexId = Geometry::VERTICAL_MIRROR_PAIRS[hexId];
+    Mask pair = (Mask(1) << hexId) | (Mask(1) << mirrorHexId);
+    if (hexValues[hexId] != hexValues[mirrorHexId]) {
+        mirrorMismatch |= pair;
+    } else {
+        mirrorMismatch &= ~pair;
+    }
+}
+
+template <int Radius>
+void HexBoard<Radius>::makeMove(const Move& move) {
+    const auto& keys = ZOBRIST_KEYS<NUM_HEXES>;
+    place(move.hexId, move.tileValue);
+
+    // Take the tile from the mover's inventory (if held: puzzle-style boards may not)
+    int count = getTileCount(currentPlayer, move.tileValue);
+    bool tookTile = count > 0;
+    if (tookTile) {
+        tiles[currentPlayer - 1] -= 1ull << (TILE_SLOTS[move.tileValue] * TILE_COUNT_BITS);
+        zobristHash ^= keys.tileTake[currentPlayer - 1][move.tileValue][count];
+    }
+
+    assert(undoCount < MAX_PLIES);
+    undoStack[undoCount++] = UndoEntry{move, tookTile};
+
+    zobristHash ^= keys.tile[move.hexId][move.tileValue] ^ keys.player[0] ^ keys.player[1];
+    currentPlayer = (currentPlayer == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+}
+
+template <int Radius>
+void HexBoard<Radius>::unmakeMove() {
+    assert(undoCount > 0);
+    const auto& keys = ZOBRIST_KEYS<NUM_HEXES>;
+    const UndoEntry& entry = undoStack[--undoCount];
+    const Move move = entry.move;
+
+    currentPlayer = (currentPlayer == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+    zobristHash ^= keys.tile[move.hexId][move.tileValue] ^ keys.player[0] ^ keys.player[1];
+
+    if (entry.tookTile) {
+        tiles[currentPlayer - 1] += 1ull << (TILE_SLOTS[move.tileValue] * TILE_COUNT_BITS);
+        zobristHash ^= keys.tileTake[currentPlayer - 1][move.tileValue][getTileCount(currentPlayer, move.tileValue)];
+    }
+
+    remove(move.hexId, move.tileValue);
+}
+
+template <int Radius>
+int HexBoard<Radius>::playout(std::mt19937& rng) {
+    Move moves[MAX_MOVES];
+    int plies = 0;
+    while (!isGameOver()) {
+        int count = generateMoves(moves);
+        if (count == 0) break;  // Side to move is stuck
+        std::uniform_int_distribution<int> dist(0, count - 1);
+        makeMove(moves[dist(rng)]);
+        plies++;
+    }
+    return plies;
+}
+
+// ============================================================================
+// Zobrist Hashing
+// ============================================================================
+
+template <int Radius>
+uint64_t HexBoard<Radius>::computeHash() const {
+    const auto& keys = ZOBRIST_KEYS<NUM_HEXES>;
+    uint64_t h = 0;
+
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (hexValues[hexId]) h ^= keys.tile[hexId][hexValues[hexId]];
+    }
+
+    h ^= Zobrist::rulesHash(keys, ruleFlags);
+    h ^= keys.player[currentPlayer - 1];
+
+    for (int player = PLAYER_1; player <= PLAYER_2; player++) {
+        for (int slot = 0; slot < NUM_TILES_PER_PLAYER; slot++) {
+            h ^= keys.tileCount[player - 1][TILE_VALUES[slot]][getTileCount(player, TILE_VALUES[slot])];
+        }
+    }
+
+    return h;
+}
+
+template class HexBoard<2>;
+template class HexBoard<3>;
+template class HexBoard<4>;
+
+} // namespace hexuki
@@ -0,0 +1,59 @@
+#include "core/legal_mask_table.h"
+#include "core/line_runs.h"
+#include "utils/timer.h"
+
+namespace hexuki {
+
+// Static member initialization
+uint32_t LegalMaskTable::table[LegalMaskTable::NUM_OCCUPANCIES] = {};
+uint32_t LegalMaskTable::adjacentTable[LegalMaskTable::NUM_OCCUPANCIES] = {};
+
+void LegalMaskTable::initialize() {
+    // Function-local static: the first caller builds the table, concurrent
+    // callers wait for it (C++11 thread-safe initialization)
+    static const bool built = [] {
+        for (uint32_t occ = 0; occ < NUM_OCCUPANCIES; occ++) {
+            table[occ] = computeLegalHexMask(occ);
+        }
+        return true;
+    }();
+    (void)built;
+}
+
+void LegalMaskTable::initializeAdjacent() {
+    // Same once-only, thread-safe build as initialize()
+    static const bool built = [] {
+        for (uint32_t occ = 0; occ < NUM_OCCUPANCIES; occ++) {
+            adjacentTable[occ] = computeAdjacentHexMask(occ);
+        }
+        return true;
+    }();
+    (void)built;
+}
+
+uint32_t LegalMaskTable::computeAdjacentHexMask(uint32_t hexOccupied) {
+    uint32_t adjacent = 0;
+    for (uint32_t occ = hexOccupied; occ; occ &= occ - 1) {
+        adjacent |= HEX_NEIGHBOR_MASKS[BitOps::countTrailingZeros(occ)];
+    }
+    return adjacent & ~hexOccupied;
+}
+
+uint32_t LegalMaskTable::computeLegalHexMask(uint32_t hexOccupied) {
+    // Candidate hexes: empty and adjacent to at least one occupied hex
+    uint32_t candidates = computeAdjacentHexMask(hexOccupied);
+
+    // Chain length constraint on each candidate
+    LineRuns runs = LineRuns::fromOccupancy(hexOccupied);
+    uint32_t legal = 0;
+    for (; candidates; candidates &= candidates - 1) {
+        int hexId = BitOps::countTrailingZeros(candidates);
+        if (runs.allowsPlacement(hexId)) {
+            legal |= (1u << hexId);
+        }
+    }
+
+    return legal;
+}
+
+} // namespace hexuki
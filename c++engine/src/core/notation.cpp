@@ -0,0 +1,245 @@
+#include "core/notation.h"
+#include "core/bitboard.h"
+
+namespace hexuki {
+
+namespace {
+
+// Cursor over the input (offsets are from the start of the text)
+struct Scanner {
+    std::string_view text;
+    size_t pos = 0;
+
+    bool done() const { return pos >= text.size(); }
+    char peek() const { return done() ? '\0' : text[pos]; }
+
+    bool accept(char c) {
+        if (peek() != c) return false;
+        pos++;
+        return true;
+    }
+
+    bool acceptPrefix(std::string_view prefix) {
+        if (text.substr(pos, prefix.size()) != prefix) return false;
+        pos += prefix.size();
+        return true;
+    }
+
+    // Unsigned decimal; saturates instead of overflowing. False if no digits.
+    bool number(int& value) {
+        size_t start = pos;
+        value = 0;
+        while (!done() && text[pos] >= '0' && text[pos] <= '9') {
+            if (value < 100000) value = value * 10 + (text[pos] - '0');
+            pos++;
+        }
+        return pos > start;
+    }
+
+    ParseStatus fail(const char* error) const { return ParseStatus{error, pos}; }
+};
+
+bool isTileValue(int value) {
+    return value >= 1 && value <= MAX_TILE_VALUE && TILE_SLOTS[value] >= 0;
+}
+
+// Comma-separated tile values up to the next '|' (empty list allowed)
+ParseStatus parseHand(Scanner& s, uint64_t& inventory) {
+    inventory = 0;
+    if (s.done() || s.peek() == '|') return ParseStatus{};
+
+    int tiles = 0;
+    do {
+        size_t start = s.pos;
+        int value;
+        if (!s.number(value)) return s.fail("expected a tile value");
+        if (!isTileValue(value)) return ParseStatus{"not a tile value", start};
+        if (++tiles > PackedPosition::MAX_TILES) return ParseStatus{"too many tiles in hand", start};
+        inventory += 1ull << (TILE_SLOTS[value] * TILE_COUNT_BITS);
+    } while (s.accept(','));
+
+    return ParseStatus{};
+}
+
+// Comma-separated "h<hex>:<value>" placements
+ParseStatus parsePlacements(Scanner& s, PackedPosition& position) {
+    do {
+        if (!s.accept('h')) return s.fail("expected 'h'");
+        size_t start = s.pos;
+        int hexId;
+        if (!s.number(hexId)) return s.fail("expected a hex id");
+        if (hexId >= NUM_HEXES) return ParseStatus{"hex id out of range", start};
+        if (!s.accept(':')) return s.fail("expected ':'");
+        start = s.pos;
+        int value;
+        if (!s.number(value)) return s.fail("expected a tile value");
+        if (!isTileValue(value)) return ParseStatus{"not a tile value", start};
+        position.setCell(hexId, TILE_SLOTS[value] + 1);
+    } while (s.accept(','));
+
+    return ParseStatus{};
+}
+
+} // namespace
+
+ParseStatus parseMove(std::string_view text, Move& move) {
+    Scanner s{text};
+    int hexId;
+    int value;
+
+    if (!s.accept('h')) return s.fail("expected 'h'");
+    size_t hexStart = s.pos;
+    if (!s.number(hexId)) return s.fail("expected a hex id");
+    if (!s.accept('t')) return s.fail("expected 't'");
+    size_t valueStart = s.pos;
+    if (!s.number(value)) return s.fail("expected a tile value");
+    if (!s.done()) return s.fail("unexpected text after move");
+
+    if (hexId >= NUM_HEXES) return ParseStatus{"hex id out of range", hexStart};
+    if (!isTileValue(value)) return ParseStatus{"not a tile value", valueStart};
+
+    move = Move(hexId, value);
+    return ParseStatus{};
+}
+
+ParseStatus parsePosition(std::string_view text, PackedPosition& position, uint8_t ruleFlags) {
+    Scanner s{text};
+    PackedPosition result;
+    uint64_t hands[2] = {FULL_TILE_INVENTORY, FULL_TILE_INVENTORY};
+    int turn = PLAYER_1;
+
+    while (!s.done()) {
+        if (s.accept('|')) continue;  // Empty section
+
+        ParseStatus status;
+        if (s.peek() == 'h') {
+            status = parsePlacements(s, result);
+        } else if (s.acceptPrefix("p1:")) {
+            status = parseHand(s, hands[0]);
+        } else if (s.acceptPrefix("p2:")) {
+            status = parseHand(s, hands[1]);
+        } else if (s.acceptPrefix("turn:")) {
+            size_t start = s.pos;
+            if (!s.number(turn)) return s.fail("expected a player");
+            if (turn != PLAYER_1 && turn != PLAYER_2) return ParseStatus{"player must be 1 or 2", start};
+        } else {
+            return s.fail("unknown section");
+        }
+        if (!status.ok()) return status;
+
+        if (!s.done() && !s.accept('|')) return s.fail("expected '|'");
+    }
+
+    result.setInventory(PLAYER_1, hands[0]);
+    result.setInventory(PLAYER_2, hands[1]);
+    result.setCurrentPlayer(turn);
+    result.setRuleFlags(ruleFlags);
+    position = result;
+    return ParseStatus{};
+}
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Next whitespace-separated token at or after pos (empty at the end)
+std::string_view nextToken(std::string_view text, size_t& pos, size_t& start) {
+    while (pos < text.size() && isSpace(text[pos])) pos++;
+    start = pos;
+    while (pos < text.size() && !isSpace(text[pos])) pos++;
+    return text.substr(start, pos - start);
+}
+
+ParseStatus at(ParseStatus status, size_t start) {
+    status.offset += start;
+    return status;
+}
+
+} // namespace
+
+ParseStatus parseGame(std::string_view text, HexukiBitboard& board) {
+    HexukiBitboard game = board;
+    size_t pos = 0;
+    size_t start = 0;
+    std::string_view token = nextToken(text, pos, start);
+
+    // Starting position (moves never contain ':')
+    if (token.find(':') != std::string_view::npos) {
+        PackedPosition position;
+        ParseStatus status = parsePosition(token, position, board.getRuleFlags());
+        if (!status.ok()) return at(status, start);
+        game.unpack(position);
+        token = nextToken(text, pos, start);
+    } else {
+        game.reset();
+    }
+
+    for (; !token.empty(); token = nextToken(text, pos, start)) {
+        Move move;
+        ParseStatus status = parseMove(token, move);
+        if (!status.ok()) return at(status, start);
+        if (!game.isValidMove(move)) return ParseStatus{"illegal move", start};
+        game.makeMove(move);
+    }
+
+    board = game;
+    return ParseStatus{};
+}
+
+// ============================================================================
+// Bulk loading
+// ============================================================================
+
+namespace {
+
+// Call onPosition(packed) for every good line of buffer
+template <typename OnPosition>
+size_t forEachPosition(std::string_view buffer, std::vector<LineParseError>* errors,
+                       uint8_t ruleFlags, OnPosition onPosition) {
+    size_t parsed = 0;
+    size_t lineNumber = 0;
+
+    while (!buffer.empty()) {
+        size_t end = buffer.find('\n');
+        std::string_view line = buffer.substr(0, end);
+        buffer.remove_prefix(end == std::string_view::npos ? buffer.size() : end + 1);
+        lineNumber++;
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        PackedPosition position;
+        ParseStatus status = parsePosition(line, position, ruleFlags);
+        if (!status.ok()) {
+            if (errors) errors->push_back(LineParseError{lineNumber, status});
+            continue;
+        }
+        onPosition(position);
+        parsed++;
+    }
+
+    return parsed;
+}
+
+} // namespace
+
+size_t parsePositions(std::string_view buffer, std::vector<PackedPosition>& positions,
+                      std::vector<LineParseError>* errors, uint8_t ruleFlags) {
+    return forEachPosition(buffer, errors, ruleFlags, [&](const PackedPosition& position) {
+        positions.push_back(position);
+    });
+}
+
+size_t parsePositions(std::string_view buffer, std::vector<HexukiBitboard>& boards,
+                      std::vector<LineParseError>* errors, uint8_t ruleFlags) {
+    // Unpack into one scratch board and copy it out (one hash per position)
+    HexukiBitboard board;
+    return forEachPosition(buffer, errors, ruleFlags, [&](const PackedPosition& position) {
+        board.unpack(position);
+        boards.push_back(board);
+    });
+}
+
+} // namespace hexuki
@@ -0,0 +1,36 @@
+#include "core/packed_position.h"
+#include <stdexcept>
+
+namespace hexuki {
+
+std::string PackedPosition::toHex() const {
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string text(32, '0');
+    for (int i = 0; i < 16; i++) {
+        text[15 - i] = DIGITS[(hi >> (4 * i)) & 0xF];
+        text[31 - i] = DIGITS[(lo >> (4 * i)) & 0xF];
+    }
+    return text;
+}
+
+PackedPosition PackedPosition::fromHex(const std::string& text) {
+    if (text.size() != 32) {
+        throw std::invalid_argument("Packed position must be 32 hex digits: " + text);
+    }
+
+    PackedPosition position;
+    for (int i = 0; i < 32; i++) {
+        char c = text[i];
+        int digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else throw std::invalid_argument("Invalid hex digit in packed position: " + text);
+
+        uint64_t& word = i < 16 ? position.hi : position.lo;
+        word = (word << 4) | static_cast<uint64_t>(digit);
+    }
+    return position;
+}
+
+} // namespace hexuki
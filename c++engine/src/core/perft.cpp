@@ -0,0 +1,130 @@
+#include "core/perft.h"
+#include "core/move_generator.h"
+#include "core/rules.h"
+#include "core/zobrist.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
+
+namespace hexuki {
+
+namespace {
+
+// The low half is already a Zobrist key, so it hashes the pair well enough
+struct LeafKeyHash {
+    size_t operator()(const HashKey128& key) const { return static_cast<size_t>(key.lo); }
+};
+
+using KeySet = std::unordered_set<HashKey128, LeafKeyHash>;
+
+// 128-bit keys, so a 64-bit collision never merges two leaves
+HashKey128 leafKey(const HexukiBitboard& board, PerftKey key) {
+    return board.getHash128(key == PerftKey::CANONICAL ? board.getCanonicalSymmetry() : 0);
+}
+
+template <typename R>
+uint64_t perftWith(HexukiBitboard& board, int depth, bool bulk, R rules) {
+    if (depth == 0) return 1;
+
+    MoveGenerator moves(board, rules);
+    if (bulk && depth == 1) return static_cast<uint64_t>(moves.count());
+
+    uint64_t nodes = 0;
+    Move move;
+    while (moves.next(move)) {
+        board.makeMove(move);
+        nodes += perftWith(board, depth - 1, bulk, rules);
+        board.unmakeMove();
+    }
+    return nodes;
+}
+
+// Same count, collecting the key of every leaf
+template <typename R>
+uint64_t perftUniqueWith(HexukiBitboard& board, int depth, PerftKey key, KeySet& keys, R rules) {
+    if (depth == 0) {
+        keys.insert(leafKey(board, key));
+        return 1;
+    }
+
+    MoveGenerator moves(board, rules);
+    uint64_t nodes = 0;
+    Move move;
+    while (moves.next(move)) {
+        board.makeMove(move);
+        nodes += perftUniqueWith(board, depth - 1, key, keys, rules);
+        board.unmakeMove();
+    }
+    return nodes;
+}
+
+// Leaves below board on this thread, keys into 'keys' when counting unique positions
+uint64_t countSubtree(HexukiBitboard& board, int depth, const PerftOptions& options, KeySet& keys) {
+    return dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        return options.unique == PerftKey::NONE
+            ? perftWith(board, depth, options.bulk, rules)
+            : perftUniqueWith(board, depth, options.unique, keys, rules);
+    });
+}
+
+} // namespace
+
+uint64_t perft(HexukiBitboard& board, int depth, bool bulk) {
+    return dispatchRules(board.getRuleFlags(), [&](auto rules) {
+        return perftWith(board, depth, bulk, rules);
+    });
+}
+
+PerftResult runPerft(const HexukiBitboard& board, const PerftOptions& options) {
+    PerftResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    if (options.depth <= 0) {
+        result.nodes = 1;
+        result.uniquePositions = options.unique == PerftKey::NONE ? 0 : 1;
+        return result;
+    }
+
+    MoveList rootMoves;
+    board.generateMoves(rootMoves);
+    result.divide.resize(rootMoves.size());
+
+    // Root moves are claimed one at a time, so uneven subtrees balance out
+    int threadCount = options.threads > 1 ? options.threads : 1;
+    std::vector<KeySet> keys(threadCount);
+    std::atomic<size_t> nextMove(0);
+
+    auto worker = [&](int thread) {
+        for (size_t i = nextMove++; i < rootMoves.size(); i = nextMove++) {
+            HexukiBitboard child = board;
+            child.makeMove(rootMoves[i]);
+            result.divide[i] = PerftDivide{rootMoves[i], countSubtree(child, options.depth - 1, options, keys[thread])};
+        }
+    };
+
+    if (threadCount == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++) threads.emplace_back(worker, t);
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    for (const PerftDivide& entry : result.divide) {
+        result.nodes += entry.nodes;
+    }
+
+    if (options.unique != PerftKey::NONE) {
+        for (int t = 1; t < threadCount; t++) {
+            keys[0].insert(keys[t].begin(), keys[t].end());
+            KeySet().swap(keys[t]);
+        }
+        result.uniquePositions = keys[0].size();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace hexuki
@@ -0,0 +1,67 @@
+#include "core/rule_variants.h"
+#include <random>
+
+namespace hexuki {
+
+namespace {
+
+const RuleVariant VARIANTS[] = {
+    {"standard", "Center start, adjacency + chain length rules",
+     DEFAULT_RULE_FLAGS, FULL_TILE_INVENTORY, FULL_TILE_INVENTORY, false},
+    {"anti-symmetry", "Standard + no move may leave the board mirrored",
+     DEFAULT_RULE_FLAGS | RULE_ANTI_SYMMETRY, FULL_TILE_INVENTORY, FULL_TILE_INVENTORY, false},
+    {"free-opening", "Anti-symmetry + P1's first tile may go on any hex",
+     DEFAULT_RULE_FLAGS | RULE_ANTI_SYMMETRY | RULE_FREE_OPENING, FULL_TILE_INVENTORY, FULL_TILE_INVENTORY, false},
+    {"asymmetric", "Standard + 9 random tile values per player (duplicates allowed)",
+     DEFAULT_RULE_FLAGS, FULL_TILE_INVENTORY, FULL_TILE_INVENTORY, true},
+    {"no-chain", "Center start, adjacency rule only",
+     RULE_CENTER_START, FULL_TILE_INVENTORY, FULL_TILE_INVENTORY, false},
+    {"empty-start", "No center tile; the first tile may go on any hex",
+     RULE_CHAIN_CONSTRAINT, FULL_TILE_INVENTORY, FULL_TILE_INVENTORY, false},
+};
+
+constexpr int NUM_VARIANTS = sizeof(VARIANTS) / sizeof(VARIANTS[0]);
+
+// NUM_TILES_PER_PLAYER uniform draws from TILE_VALUES (as the asymmetric JS engine)
+uint64_t dealRandomTiles(std::mt19937& rng) {
+    std::uniform_int_distribution<int> slotDist(0, NUM_TILES_PER_PLAYER - 1);
+    uint64_t inventory = 0;
+    for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+        inventory += 1ull << (slotDist(rng) * TILE_COUNT_BITS);
+    }
+    return inventory;
+}
+
+} // namespace
+
+void RuleVariant::setup(HexukiBitboard& board, uint32_t seed) const {
+    board.setRuleFlags(flags);
+    board.reset();
+
+    uint64_t p1 = p1Tiles;
+    uint64_t p2 = p2Tiles;
+    if (randomTiles) {
+        std::mt19937 rng(seed);
+        p1 = dealRandomTiles(rng);
+        p2 = dealRandomTiles(rng);
+    }
+    board.setTileInventory(PLAYER_1, p1);
+    board.setTileInventory(PLAYER_2, p2);
+}
+
+int RuleRegistry::count() {
+    return NUM_VARIANTS;
+}
+
+const RuleVariant& RuleRegistry::get(int index) {
+    return VARIANTS[index];
+}
+
+const RuleVariant* RuleRegistry::find(const std::string& name) {
+    for (const RuleVariant& variant : VARIANTS) {
+        if (name == variant.name) return &variant;
+    }
+    return nullptr;
+}
+
+} // namespace hexuki
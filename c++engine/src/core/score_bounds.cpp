@@ -0,0 +1,52 @@
+#include "core/score_bounds.h"
+#include <algorithm>
+
+namespace hexuki {
+
+namespace {
+
+constexpr int MAX_CHAIN_LENGTH = BoardGeometry::MAX_CHAIN_LENGTH;
+constexpr int64_t BOUND_LIMIT = INT32_MAX / 4;  // Keeps margins and negation in int range
+
+constexpr bool tileValuesAscending() {
+    for (int i = 1; i < NUM_TILES_PER_PLAYER; i++) {
+        if (TILE_VALUES[i] <= TILE_VALUES[i - 1]) return false;
+    }
+    return true;
+}
+
+static_assert(tileValuesAscending(), "Largest tiles are read from the highest slots down");
+
+} // namespace
+
+ScoreBounds ScoreBounds::compute(const int32_t (&chainProducts)[2][CHAINS_PER_PLAYER],
+                                 const int32_t (&scores)[2],
+                                 uint32_t occupied, uint64_t p1Tiles, uint64_t p2Tiles) {
+    // gain[k] = best factor k more tiles can put on one chain: the product of
+    // the k largest tiles left in both hands (missing tiles leave hexes at 1)
+    int64_t gain[MAX_CHAIN_LENGTH + 1];
+    gain[0] = 1;
+    int k = 0;
+    for (int slot = NUM_TILES_PER_PLAYER - 1; slot >= 0 && k < MAX_CHAIN_LENGTH; slot--) {
+        int shift = slot * TILE_COUNT_BITS;
+        int count = static_cast<int>(((p1Tiles >> shift) & TILE_COUNT_MASK) + ((p2Tiles >> shift) & TILE_COUNT_MASK));
+        for (; count > 0 && k < MAX_CHAIN_LENGTH; count--, k++) {
+            gain[k + 1] = std::min(gain[k] * TILE_VALUES[slot], BOUND_LIMIT);
+        }
+    }
+    for (; k < MAX_CHAIN_LENGTH; k++) gain[k + 1] = gain[k];
+
+    ScoreBounds bounds;
+    for (int p = 0; p < 2; p++) {
+        int64_t upper = 0;
+        for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+            int empty = BitOps::popcount(SCORING_CHAIN_MASKS[p][c] & ~occupied);
+            upper += std::min(chainProducts[p][c] * gain[empty], BOUND_LIMIT);
+        }
+        bounds.lower[p] = scores[p];
+        bounds.upper[p] = static_cast<int32_t>(std::min(upper, BOUND_LIMIT));
+    }
+    return bounds;
+}
+
+} // namespace hexuki
@@ -61,6 +61,9 @@ int main() {
         std::cout << "\n";
     }
 
+    // Game record from the board's move history
+    std::cout << "Game record: " << game.toNotation() << "\n\n";
+
     // Test unmake
     std::cout << "Testing unmake...\n";
     game.unmakeMove();
@@ -68,6 +71,9 @@ int main() {
     game.print();
     std::cout << "\n";
 
+    // Compact binary form (16 bytes, see PackedPosition)
+    std::cout << "Packed position: " << game.pack().toHex() << "\n\n";
+
     // Final stats
     std::cout << "===========================================\n";
     std::cout << "PHASE 1 TESTS COMPLETE\n";
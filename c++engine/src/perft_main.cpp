@@ -0,0 +1,115 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include "core/bitboard.h"
+#include "core/perft.h"
+#include "core/rule_variants.h"
+#include "core/zobrist.h"
+
+using namespace hexuki;
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: hexuki_perft [depth] [options]\n"
+              << "  --depth N            Plies to search (default 4)\n"
+              << "  --position TEXT      Start from a loadPosition string (default: new game)\n"
+              << "  --variant NAME       Rule variant (standard, anti-symmetry, free-opening, ...)\n"
+              << "  --threads N          Worker threads (default: all cores)\n"
+              << "  --no-bulk            Make every last-ply move instead of counting them\n"
+              << "  --unique hash|canonical\n"
+              << "                       Also count distinct leaf positions by Zobrist or canonical key\n";
+}
+
+// Whole text as a count (depth, threads): negative values are rejected
+bool parseInt(const char* text, int& value) {
+    try {
+        size_t used = 0;
+        value = std::stoi(text, &used);
+        return text[used] == '\0' && value >= 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    PerftOptions options;
+    options.depth = 4;
+    options.threads = static_cast<int>(std::thread::hardware_concurrency());
+    std::string position;
+    std::string variantName = "standard";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else if (arg == "--depth" && hasValue) {
+            if (!parseInt(argv[++i], options.depth)) { printUsage(); return 1; }
+        } else if (arg == "--threads" && hasValue) {
+            if (!parseInt(argv[++i], options.threads)) { printUsage(); return 1; }
+        } else if (arg == "--position" && hasValue) {
+            position = argv[++i];
+        } else if (arg == "--variant" && hasValue) {
+            variantName = argv[++i];
+        } else if (arg == "--no-bulk") {
+            options.bulk = false;
+        } else if (arg == "--unique" && hasValue) {
+            std::string key = argv[++i];
+            if (key == "hash") {
+                options.unique = PerftKey::HASH;
+            } else if (key == "canonical") {
+                options.unique = PerftKey::CANONICAL;
+            } else {
+                printUsage();
+                return 1;
+            }
+        } else if (!parseInt(argv[i], options.depth)) {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Zobrist::initialize();
+
+    const RuleVariant* variant = RuleRegistry::find(variantName);
+    if (!variant) {
+        std::cerr << "Unknown variant: " << variantName << "\n";
+        return 1;
+    }
+
+    HexukiBitboard board;
+    variant->setup(board);
+    if (!position.empty() && !board.loadPosition(position)) {
+        std::cerr << "Invalid position: " << position << "\n";
+        return 1;
+    }
+
+    std::cout << "Position: " << board.savePosition() << "\n";
+    std::cout << "Variant:  " << variant->name << "\n";
+    std::cout << "Depth " << options.depth << ", " << (options.threads > 1 ? options.threads : 1) << " thread(s), "
+              << (options.bulk && options.unique == PerftKey::NONE ? "bulk" : "full") << " counting\n\n";
+
+    PerftResult result = runPerft(board, options);
+
+    for (const PerftDivide& entry : result.divide) {
+        std::cout << entry.move.toString() << ": " << entry.nodes << "\n";
+    }
+
+    std::cout << "\nMoves:  " << result.divide.size() << "\n";
+    std::cout << "Nodes:  " << result.nodes << "\n";
+    if (options.unique != PerftKey::NONE) {
+        std::cout << "Unique: " << result.uniquePositions
+                  << (options.unique == PerftKey::CANONICAL ? " (canonical)" : " (hash)") << "\n";
+    }
+    std::cout << std::fixed << std::setprecision(3)
+              << "Time:   " << result.seconds << " s\n"
+              << std::setprecision(0)
+              << "NPS:    " << result.nodesPerSecond() << "\n";
+    return 0;
+}
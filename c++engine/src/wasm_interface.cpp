@@ -8,6 +8,8 @@
 #include "core/bitboard.h"
 #include "core/zobrist.h"
 #include "core/move.h"
+#include "core/move_generator.h"
+#include "core/rule_variants.h"
 #include "ai/mcts.h"
 #include "ai/minimax.h"
 #include <emscripten/emscripten.h>
@@ -25,7 +27,6 @@ using namespace emscripten;
 static HexukiBitboard* g_board = nullptr;
 static mcts::MCTS* g_mcts = nullptr;
 static bool g_initialized = false;
-static Move g_lastMove(-1, 0);  // Track last move for unmake
 
 // ============================================================================
 // Initialization
@@ -48,6 +49,23 @@ extern "C" void wasmReset() {
     }
 }
 
+// Production rules enforce anti-symmetry; the flag persists across reset/loadPosition
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmSetAntiSymmetry(bool enabled) {
+    if (g_board) {
+        g_board->setAntiSymmetry(enabled);
+    }
+}
+
+// Switch to a named variant (see RuleRegistry) and start a new game; false if unknown
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmSetRuleVariant(const char* name, uint32_t seed) {
+    const RuleVariant* variant = RuleRegistry::find(name);
+    if (!g_board || !variant) return false;
+    variant->setup(*g_board, seed);
+    return true;
+}
+
 // ============================================================================
 // Game State Management
 // ============================================================================
@@ -55,7 +73,7 @@ extern "C" void wasmReset() {
 EMSCRIPTEN_KEEPALIVE
 extern "C" void wasmLoadPosition(const char* position) {
     if (g_board) {
-        g_board->loadPosition(std::string(position));
+        g_board->loadPosition(position);
     }
 }
 
@@ -69,6 +87,33 @@ extern "C" const char* wasmSavePosition() {
     return "";
 }
 
+// Binary position (PackedPosition) as four 32-bit words, low word first:
+// call wasmGetPackedWord(0..3) after wasmPackPosition()
+static PackedPosition g_packed;
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmPackPosition() {
+    if (g_board) {
+        g_packed = g_board->pack();
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" uint32_t wasmGetPackedWord(int index) {
+    uint64_t word = (index < 2) ? g_packed.lo : g_packed.hi;
+    return static_cast<uint32_t>(word >> ((index & 1) * 32));
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmUnpackPosition(uint32_t w0, uint32_t w1, uint32_t w2, uint32_t w3) {
+    if (g_board) {
+        PackedPosition position;
+        position.lo = (static_cast<uint64_t>(w1) << 32) | w0;
+        position.hi = (static_cast<uint64_t>(w3) << 32) | w2;
+        g_board->unpack(position);
+    }
+}
+
 EMSCRIPTEN_KEEPALIVE
 extern "C" int wasmGetCurrentPlayer() {
     return g_board ? g_board->getCurrentPlayer() : 1;
@@ -104,8 +149,7 @@ extern "C" bool wasmMakeMove(int hexId, int tileValue) {
 
     Move move(hexId, tileValue);
     if (g_board->isValidMove(move)) {
-        g_lastMove = move;  // Track for unmake
-        g_board->makeMove(move);
+        g_board->makeMove(move);  // Recorded in the board's move history
         return true;
     }
     return false;
@@ -113,16 +157,41 @@ extern "C" bool wasmMakeMove(int hexId, int tileValue) {
 
 EMSCRIPTEN_KEEPALIVE
 extern "C" void wasmUnmakeMove() {
-    if (g_board && g_lastMove.hexId != -1) {
-        g_board->unmakeMove(g_lastMove);
-        g_lastMove = Move(-1, 0);  // Reset
+    if (g_board && g_board->getPly() > 0) {
+        g_board->unmakeMove();
     }
 }
 
+// Undo back to a ply (0 = start of the game / last loaded position)
+EMSCRIPTEN_KEEPALIVE
+extern "C" void wasmUndoToPly(int ply) {
+    if (g_board) {
+        g_board->undoToPly(ply);
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" int wasmGetPly() {
+    return g_board ? g_board->getPly() : 0;
+}
+
+// Game record (see HexukiBitboard::toNotation)
+EMSCRIPTEN_KEEPALIVE
+extern "C" const char* wasmGetNotation() {
+    static std::string result;
+    result = g_board ? g_board->toNotation() : "";
+    return result.c_str();
+}
+
+EMSCRIPTEN_KEEPALIVE
+extern "C" bool wasmLoadNotation(const char* notation) {
+    return g_board && g_board->fromNotation(notation);
+}
+
 EMSCRIPTEN_KEEPALIVE
 extern "C" int wasmGetValidMovesCount() {
     if (!g_board) return 0;
-    return g_board->getValidMoves().size();
+    return MoveGenerator(*g_board).count();  // Counted from the masks, nothing enumerated
 }
 
 // Returns valid moves as a JSON string: "[{h:6,t:5},{h:7,t:4},...]"
@@ -134,12 +203,13 @@ extern "C" const char* wasmGetValidMoves() {
         return result.c_str();
     }
 
-    auto moves = g_board->getValidMoves();
+    MoveGenerator moves(*g_board);
+    Move move;
     result = "[";
-    for (size_t i = 0; i < moves.size(); i++) {
-        result += "{\"h\":" + std::to_string(moves[i].hexId) +
-                  ",\"t\":" + std::to_string(moves[i].tileValue) + "}";
-        if (i < moves.size() - 1) result += ",";
+    while (moves.next(move)) {
+        if (result.size() > 1) result += ",";
+        result += "{\"h\":" + std::to_string(move.hexId) +
+                  ",\"t\":" + std::to_string(move.tileValue) + "}";
     }
     result += "]";
     return result.c_str();
@@ -244,10 +314,22 @@ void wasmLoadPositionStr(std::string position) {
     wasmLoadPosition(position.c_str());
 }
 
+bool wasmSetRuleVariantStr(std::string name, uint32_t seed) {
+    return wasmSetRuleVariant(name.c_str(), seed);
+}
+
 std::string wasmSavePositionStr() {
     return std::string(wasmSavePosition());
 }
 
+std::string wasmGetNotationStr() {
+    return std::string(wasmGetNotation());
+}
+
+bool wasmLoadNotationStr(std::string notation) {
+    return wasmLoadNotation(notation.c_str());
+}
+
 std::string wasmGetValidMovesStr() {
     return std::string(wasmGetValidMoves());
 }
@@ -267,8 +349,13 @@ std::string wasmMinimaxFindBestMoveStr(int depth, int timeLimitMs) {
 EMSCRIPTEN_BINDINGS(hexuki_module) {
     function("initialize", &wasmInitialize);
     function("reset", &wasmReset);
+    function("setAntiSymmetry", &wasmSetAntiSymmetry);
+    function("setRuleVariant", &wasmSetRuleVariantStr);
     function("loadPosition", &wasmLoadPositionStr);
     function("savePosition", &wasmSavePositionStr);
+    function("packPosition", &wasmPackPosition);
+    function("getPackedWord", &wasmGetPackedWord);
+    function("unpackPosition", &wasmUnpackPosition);
     function("getCurrentPlayer", &wasmGetCurrentPlayer);
     function("getScoreP1", &wasmGetScoreP1);
     function("getScoreP2", &wasmGetScoreP2);
@@ -276,6 +363,10 @@ EMSCRIPTEN_BINDINGS(hexuki_module) {
     function("getTileValue", &wasmGetTileValue);
     function("makeMove", &wasmMakeMove);
     function("unmakeMove", &wasmUnmakeMove);
+    function("undoToPly", &wasmUndoToPly);
+    function("getPly", &wasmGetPly);
+    function("getNotation", &wasmGetNotationStr);
+    function("loadNotation", &wasmLoadNotationStr);
     function("getValidMovesCount", &wasmGetValidMovesCount);
     function("getValidMoves", &wasmGetValidMovesStr);
     function("mctsFindBestMove", &wasmMCTSFindBestMoveStr);
@@ -1,8 +1,23 @@
 #include "core/bitboard.h"
 #include "core/move.h"
 #include "core/zobrist.h"
+#include "core/legal_mask_table.h"
+#include "core/move_generator.h"
+#include "core/board_batch.h"
+#include "core/rule_variants.h"
+#include "core/notation.h"
+#include "core/hex_board.h"
+#include "core/perft.h"
+#include "ai/minimax.h"
+#include "ai/endgame_solver.h"
+#include "ai/move_ordering.h"
+#include <chrono>
+#include <set>
+#include <unordered_set>
+#include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <random>
 
 using namespace hexuki;
 
@@ -43,10 +58,53 @@ void testMoveGeneration() {
     auto moves = board.getValidMoves();
     assert(moves.size() > 0);
 
+    // MoveList path must produce the same moves in the same order
+    MoveList moveList;
+    board.generateMoves(moveList);
+    assert(moveList.size() == moves.size());
+    for (size_t i = 0; i < moves.size(); i++) {
+        assert(moveList[i] == moves[i]);
+    }
+
     // First move: all adjacent hexes to center (6 hexes) × 9 tiles = 54 moves
     std::cout << "✓ Move generation test passed (" << moves.size() << " first moves)\n";
 }
 
+void testMoveGenerator() {
+    // Walk a few games (including a duplicate-tile inventory) and check the
+    // lazy generator against the materialized list at every ply
+    const char* starts[] = {"", "h9:1|p1:3,3,3,3|p2:1,1,2,9|turn:1"};
+    std::mt19937 rng(7);
+    for (const char* start : starts) {
+        HexukiBitboard board;
+        if (*start) board.loadPosition(start);
+
+        while (true) {
+            MoveList moves;
+            board.generateMoves(moves);
+            MoveGenerator generator(board);
+            assert(generator.count() == (int)moves.size());
+            assert(generator.empty() == moves.empty());
+
+            Move move;
+            size_t i = 0;
+            while (generator.next(move)) {
+                assert(move == moves[i]);
+                assert(generator.nth((int)i) == moves[i]);
+                i++;
+            }
+            assert(i == moves.size());
+
+            if (moves.empty()) break;
+            Move pick = MoveGenerator(board).random(rng);
+            assert(board.isValidMove(pick));
+            board.makeMove(pick);
+        }
+    }
+
+    std::cout << "✓ Move generator matches generateMoves\n";
+}
+
 void testTileAvailability() {
     HexukiBitboard board;
 
@@ -132,6 +190,45 @@ void testChainScoring() {
     std::cout << "✓ Chain scoring test passed\n";
 }
 
+void testIncrementalScoring() {
+    HexukiBitboard board;
+    [[maybe_unused]] int startP1 = board.getScore(PLAYER_1);
+    [[maybe_unused]] int startP2 = board.getScore(PLAYER_2);
+
+    // Play a full game, comparing incremental scores against a reloaded board
+    // (loadPosition rebuilds chain products from scratch)
+    std::vector<Move> played;
+    MoveList moves;
+    for (int ply = 0; !board.isGameOver(); ply++) {
+        board.generateMoves(moves);
+        if (moves.empty()) break;
+        Move move = moves[(ply * 7) % moves.size()];
+        board.makeMove(move);
+        played.push_back(move);
+
+        HexukiBitboard reloaded;
+        reloaded.loadPosition(board.savePosition());
+        int chainSum = 0;
+        for (int c = 0; c < CHAINS_PER_PLAYER; c++) {
+            assert(board.getChainProduct(PLAYER_1, c) == reloaded.getChainProduct(PLAYER_1, c));
+            assert(board.getChainProduct(PLAYER_2, c) == reloaded.getChainProduct(PLAYER_2, c));
+            chainSum += board.getChainProduct(PLAYER_1, c);
+        }
+        assert(board.getScore(PLAYER_1) == reloaded.getScore(PLAYER_1));
+        assert(board.getScore(PLAYER_2) == reloaded.getScore(PLAYER_2));
+        assert(board.getScore(PLAYER_1) == chainSum);
+    }
+
+    // Unmaking everything restores the starting totals
+    for (auto it = played.rbegin(); it != played.rend(); ++it) {
+        board.unmakeMove(*it);
+    }
+    assert(board.getScore(PLAYER_1) == startP1);
+    assert(board.getScore(PLAYER_2) == startP2);
+
+    std::cout << "✓ Incremental scoring test passed (" << played.size() << " plies)\n";
+}
+
 void testAntiSymmetry() {
     HexukiBitboard board;
 
@@ -155,6 +252,1155 @@ void testAntiSymmetry() {
     std::cout << "✓ Anti-symmetry test passed\n";
 }
 
+// Reference scan: is every off-center hex equal to its mirror?
+bool scanMirrored(const HexukiBitboard& board) {
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        if (board.getTileValue(hexId) != board.getTileValue(VERTICAL_MIRROR_PAIRS[hexId])) return false;
+    }
+    return true;
+}
+
+void testAntiSymmetryRule() {
+    HexukiBitboard board;
+    board.setAntiSymmetry(true);
+
+    // First move is exempt; afterwards copying the mirror is rejected
+    board.makeMove(Move(6, 5));
+    assert(!board.isValidMove(Move(7, 5)));
+    assert(board.isValidMove(Move(7, 4)));
+    for ([[maybe_unused]] const auto& move : board.getValidMoves()) {
+        assert(!(move == Move(7, 5)));
+    }
+
+    // A center column opening leaves the board mirrored: no center column replies
+    board.reset();
+    assert(board.isAntiSymmetryEnabled());  // Flag survives reset
+    board.makeMove(Move(4, 5));
+    assert(board.isBoardMirrored());
+    for ([[maybe_unused]] const auto& move : board.getValidMoves()) {
+        assert(VERTICAL_MIRROR_PAIRS[move.hexId] != move.hexId);
+    }
+
+    // Random games: rule-filtered moves, generator and the reference scan agree
+    std::mt19937 rng(11);
+    for (int game = 0; game < 200; game++) {
+        board.reset();
+        while (true) {
+            MoveList moves;
+            board.generateMoves(moves);
+
+            // Candidates = rule-free cross product
+            HexukiBitboard unruled = board;
+            unruled.setAntiSymmetry(false);
+            MoveList candidates;
+            unruled.generateMoves(candidates);
+
+            size_t kept = 0;
+            for (const auto& move : candidates) {
+                HexukiBitboard after = board;
+                after.makeMove(move);
+                bool rejected = board.isAntiSymmetryActive() && scanMirrored(after);
+                assert(board.isValidMove(move) == !rejected);
+                if (!rejected) {
+                    assert(moves[kept] == move);
+                    kept++;
+                }
+            }
+            assert(kept == moves.size());
+
+            MoveGenerator generator(board);
+            assert(generator.count() == (int)moves.size());
+            for (size_t i = 0; i < moves.size(); i++) {
+                assert(generator.nth((int)i) == moves[i]);
+            }
+
+            if (moves.empty()) break;
+            board.makeMove(moves[rng() % moves.size()]);
+            assert(board.isBoardMirrored() == scanMirrored(board));
+        }
+    }
+
+    std::cout << "✓ Anti-symmetry rule test passed\n";
+}
+
+void testUndoStack() {
+    HexukiBitboard board;
+    board.setAntiSymmetry(true);
+
+    // Snapshot every ply of a full game, then unwind with unmakeMove()
+    std::vector<std::string> positions;
+    std::vector<uint64_t> hashes;
+    std::vector<int> scores;
+    std::vector<uint32_t> mirrors;
+    std::mt19937 rng(3);
+    MoveList moves;
+    while (true) {
+        positions.push_back(board.savePosition());
+        hashes.push_back(board.getHash());
+        scores.push_back(board.getScore(PLAYER_1) * 100000 + board.getScore(PLAYER_2));
+        mirrors.push_back(board.getMirrorMismatch());
+
+        board.generateMoves(moves);
+        if (moves.empty()) break;
+        Move move = moves[rng() % moves.size()];
+        board.makeMove(move);
+        assert(board.getLastMove() == move);
+        assert(board.getPly() == (int)positions.size());
+    }
+
+    for (int ply = board.getPly(); ply > 0; ply--) {
+        board.unmakeMove();
+        assert(board.getPly() == ply - 1);
+        assert(board.savePosition() == positions[ply - 1]);
+        assert(board.getHash() == hashes[ply - 1]);
+        assert(board.getScore(PLAYER_1) * 100000 + board.getScore(PLAYER_2) == scores[ply - 1]);
+        assert(board.getMirrorMismatch() == mirrors[ply - 1]);
+    }
+
+    // Setup edits start a fresh stack
+    board.makeMove(Move(6, 5));
+    board.setHexValue(7, 3);
+    assert(board.getPly() == 0);
+
+    std::cout << "✓ Undo stack test passed\n";
+}
+
+void testSymmetricHashing() {
+    // Play a game and its image under each symmetry side by side; the image
+    // of the standard start has P2 to move when the symmetry swaps players
+    std::mt19937 rng(5);
+    for (int s = 1; s < NUM_SYMMETRIES; s++) {
+        HexukiBitboard board;
+        HexukiBitboard image;
+        image.loadPosition(SYMMETRY_SWAPS_PLAYERS[s] ? "h9:1|turn:2" : "h9:1|turn:1");
+        assert(board.getSymmetricHash(s) == image.getHash());
+
+        MoveList moves;
+        while (true) {
+            assert(board.getSymmetricHash(s) == image.getHash());
+            assert(image.getSymmetricHash(s) == board.getHash());
+            assert(board.getCanonicalHash() == image.getCanonicalHash());
+            assert(board.getScore(PLAYER_1) == image.getScore(symmetricPlayer(s, PLAYER_1)));
+            assert(Zobrist::hash(board, s) == Zobrist::hash(image));
+
+            board.generateMoves(moves);
+            if (moves.empty()) break;
+            Move move = moves[rng() % moves.size()];
+            assert(image.isValidMove(move.transformed(s)));
+            assert(move.transformed(s).transformed(s) == move);
+            board.makeMove(move);
+            image.makeMove(move.transformed(s));
+        }
+    }
+
+    // The first moves h6 and h12 are 180 degree rotations of each other
+    HexukiBitboard a;
+    HexukiBitboard b;
+    a.makeMove(Move(6, 5));
+    b.makeMove(Move(12, 5));
+    assert(a.getHash() != b.getHash());
+    assert(a.getCanonicalHash() == b.getCanonicalHash());
+
+    std::cout << "✓ Symmetric hashing test passed\n";
+}
+
+void testIncrementalHashing() {
+    // Tables are compile-time constants; empty hands hash to 0
+    static_assert(Zobrist::KEYS.tile[CENTER_HEX][STARTING_TILE] != 0, "Keys must be generated");
+    static_assert(Zobrist::KEYS.tileCount[0][1][0] == 0, "A count of 0 must hash to 0");
+    static_assert((Zobrist::KEYS.tileCount[1][5][3] ^ Zobrist::KEYS.tileCount[1][5][2]) == Zobrist::KEYS.tileTake[1][5][3],
+                  "Taking a tile must be one XOR");
+
+    // Every symmetric hash equals a recompute after every make and unmake,
+    // including hands with duplicates and tiles nobody holds
+    const char* starts[] = {"", "h9:1,h4:3,h6:5|p1:2,7,8,9|p2:1,1,4,5,6,6,6,9|turn:2", "h9:1|p1:3,3,3|p2:|turn:1"};
+    std::mt19937 rng(17);
+    for (const char* start : starts) {
+        for (int game = 0; game < 20; game++) {
+            HexukiBitboard board;
+            if (*start) {
+                [[maybe_unused]] bool ok = board.loadPosition(start);
+                assert(ok);
+            }
+            MoveList moves;
+            while (true) {
+                for (int s = 0; s < NUM_SYMMETRIES; s++) {
+                    assert(board.getSymmetricHash(s) == Zobrist::hash(board, s));
+                }
+                board.generateMoves(moves);
+                if (moves.empty()) break;
+                board.makeMove(moves[rng() % moves.size()]);
+            }
+            while (board.getPly() > 0) {
+                board.unmakeMove();
+                assert(board.getHash() == Zobrist::hash(board));
+            }
+        }
+    }
+
+    // A position reached by play and the same position loaded from text (or
+    // bytes) share a key, so loaded positions hit entries stored during search
+    HexukiBitboard played;
+    played.makeMove(Move(6, 5));
+    played.makeMove(Move(7, 4));
+    played.makeMove(Move(2, 1));
+    HexukiBitboard loaded;
+    [[maybe_unused]] bool ok = loaded.loadPosition(played.savePosition());
+    assert(ok);
+    assert(loaded.getHash() == played.getHash());
+    assert(loaded.getCanonicalHash() == played.getCanonicalHash());
+    assert(loaded.getHash128() == played.getHash128());
+    HexukiBitboard unpacked;
+    unpacked.unpack(played.pack());
+    assert(unpacked.getHash() == played.getHash());
+
+    // Same tiles on the board but different hands: different keys
+    HexukiBitboard swapped;
+    swapped.makeMove(Move(6, 4));
+    swapped.makeMove(Move(7, 5));
+    swapped.makeMove(Move(2, 1));
+    HexukiBitboard original;
+    original.loadPosition("h9:1,h6:4,h7:5,h2:1|p1:2,3,4,5,6,7,8,9|p2:1,2,3,5,6,7,8,9|turn:2");
+    assert(swapped.getHash() != original.getHash());
+    assert(swapped.getHash128() != original.getHash128());
+
+    std::cout << "✓ Incremental hashing test passed\n";
+}
+
+void testTranspositionTable() {
+    using minimax::TTEntry;
+
+    // Size is a power of two number of 64-byte buckets within the budget
+    minimax::TranspositionTable tt(1);
+    assert(tt.getCapacity() == (1u << 20) / 64 * minimax::TranspositionTable::BUCKET_ENTRIES);
+    assert(tt.getCapacity() * 16 <= (1u << 20));
+
+    // Round trip: negative scores, every flag, every move, and no move
+    TTEntry entry;
+    assert(!tt.probe(12345, entry));
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        for (int i = 0; i < NUM_TILES_PER_PLAYER; i++) {
+            uint64_t key = 0x9E3779B97F4A7C15ull * (hexId * NUM_TILES_PER_PLAYER + i + 1);
+            TTEntry::Flag flag = static_cast<TTEntry::Flag>(i % 3);
+            tt.store(key, TTEntry(-700000 + hexId * 1000 + i, hexId, flag, Move(hexId, TILE_VALUES[i])));
+            assert(tt.probe(key, entry));
+            assert(entry.score == -700000 + hexId * 1000 + i && entry.depth == hexId && entry.flag == flag);
+            assert(entry.bestMove == Move(hexId, TILE_VALUES[i]));
+        }
+    }
+    tt.store(777, TTEntry(5, 3, TTEntry::EXACT, Move()));
+    assert(tt.probe(777, entry) && !entry.bestMove.isValid());
+
+    // Same bucket (same low bits): a fifth key evicts the shallowest entry
+    minimax::TranspositionTable small(0);  // One bucket
+    assert(small.getCapacity() == 4);
+    for (int i = 0; i < 4; i++) small.store(100 + i, TTEntry(i, 10 + i, TTEntry::EXACT, Move()));
+    small.store(200, TTEntry(0, 5, TTEntry::EXACT, Move()));
+    assert(!small.probe(100, entry));
+    assert(small.probe(101, entry) && small.probe(200, entry));
+
+    // A shallower result for the same key doesn't overwrite a current deeper one...
+    small.store(103, TTEntry(99, 1, TTEntry::UPPER_BOUND, Move()));
+    assert(small.probe(103, entry) && entry.depth == 13 && entry.score == 3);
+    // ...but does once the deeper one is from an earlier search, and old entries go first
+    small.newSearch();
+    assert(small.getUsagePermille() == 0);
+    small.store(103, TTEntry(99, 1, TTEntry::UPPER_BOUND, Move()));
+    assert(small.probe(103, entry) && entry.depth == 1 && entry.score == 99);
+    small.store(300, TTEntry(0, 0, TTEntry::EXACT, Move()));
+    assert(small.probe(103, entry) && small.probe(300, entry));
+    assert(small.getUsagePermille() == 500);
+
+    small.clear();
+    assert(!small.probe(103, entry));
+
+    // Search honours the caller's table and fills it
+    HexukiBitboard board;
+    board.loadPosition("h9:1,h6:5,h7:4,h4:3,h11:2,h12:6|p1:1,2,4,7,8,9|p2:1,3,5,7,8,9|turn:1");
+    minimax::SearchConfig config;
+    config.maxDepth = 4;
+    config.tt = &tt;
+    minimax::SearchResult result = minimax::findBestMove(board, config);
+    assert(board.isValidMove(result.bestMove));
+    assert(result.ttHits > 0 && tt.getUsagePermille() > 0);
+
+    std::cout << "✓ Transposition table test passed\n";
+}
+
+void testLazySmp() {
+    // Searched to the end of the game the score is exact, so every thread
+    // count must agree; helpers only change what the shared TT holds
+    std::mt19937 rng(19);
+    for (int game = 0; game < 3; game++) {
+        HexukiBitboard board;
+        for (int ply = 0; ply < 10; ply++) {
+            MoveList moves;
+            board.generateMoves(moves);
+            board.makeMove(moves[rng() % moves.size()]);
+        }
+
+        minimax::SearchConfig config;
+        config.maxDepth = MAX_PLIES;
+        config.ttSizeMB = 4;
+        minimax::SearchResult single = minimax::findBestMove(board, config);
+
+        minimax::TranspositionTable shared(4);
+        config.tt = &shared;
+        config.threads = 3;
+        minimax::SearchResult smp = minimax::findBestMove(board, config);
+        assert(smp.score == single.score);
+        assert(board.isValidMove(smp.bestMove));
+        assert(smp.threadNodes.size() == 3);
+        int64_t total = 0;
+        for (int64_t nodes : smp.threadNodes) total += nodes;
+        assert(total == smp.nodesSearched);
+    }
+
+    std::cout << "✓ Lazy SMP test passed\n";
+}
+
+void testPrincipalVariation() {
+    // Endgames searched to the end: PVS with aspiration windows must give the
+    // plain alpha-beta score, and the PV must be a legal line that ends the
+    // game with exactly that score
+    std::mt19937 rng(20);
+    for (int game = 0; game < 4; game++) {
+        HexukiBitboard board;
+        for (int ply = 0; ply < 10; ply++) {
+            MoveList moves;
+            board.generateMoves(moves);
+            board.makeMove(moves[rng() % moves.size()]);
+        }
+
+        minimax::TranspositionTable fresh(4);
+        int64_t nodes = 0;
+        [[maybe_unused]] int expected = minimax::alphaBeta(board, MAX_PLIES, -1000000, 1000000, fresh, nodes,
+                                                           std::chrono::steady_clock::now(), 600000);
+
+        minimax::TranspositionTable tt(4);
+        minimax::SearchConfig config;
+        config.maxDepth = MAX_PLIES;
+        config.tt = &tt;
+        minimax::SearchResult result = minimax::findBestMove(board, config);
+        assert(result.score == expected);
+        assert(!result.pv.empty() && result.pv[0] == result.bestMove);
+
+        HexukiBitboard line = board;
+        for (const Move& move : result.pv) {
+            assert(line.isValidMove(move));
+            line.makeMove(move);
+        }
+        assert(line.isGameOver());
+        assert((result.pv.size() % 2 ? -1 : 1) * minimax::evaluate(line) == result.score);
+        assert(minimax::formatPv(result.pv).rfind(result.bestMove.toString(), 0) == 0);
+    }
+
+    std::cout << "✓ Principal variation test passed\n";
+}
+
+void testMoveOrdering() {
+    using minimax::MoveOrdering;
+    MoveOrdering ordering;
+    Move previous(6, 5);
+    Move ttMove(7, 4);
+    Move killer(2, 1);
+    Move quiet(3, 9);
+
+    // A cutoff makes a killer and a countermove, credits the move and debits
+    // the ones tried before it
+    Move tried[] = {quiet};
+    ordering.recordCutoff(killer, 3, 0, previous, 4, tried, 1);
+    assert(ordering.getKiller(3, 0) == killer);
+    assert(ordering.getCounterMove(previous) == killer);
+    assert(ordering.getHistory(0, killer) == 16 && ordering.getHistory(0, quiet) == -16);
+    assert(ordering.getHistory(1, killer) == 0);
+
+    assert(ordering.score(ttMove, 3, 0, previous, ttMove) > ordering.score(killer, 3, 0, previous, ttMove));
+    assert(ordering.score(killer, 3, 0, previous, ttMove) > ordering.score(killer, 4, 0, previous, ttMove));  // Countermove only
+    assert(ordering.score(killer, 4, 0, previous, ttMove) > ordering.score(killer, 4, 0, Move(1, 1), ttMove));
+    assert(ordering.score(killer, 4, 0, Move(1, 1), ttMove) == 16 + minimax::staticMoveScore(killer));  // History
+
+    // History stays bounded however often a move cuts
+    for (int i = 0; i < 100000; i++) ordering.recordCutoff(quiet, 5, 1, Move(), MAX_PLIES, nullptr, 0);
+    assert(ordering.getHistory(1, quiet) > 0 && ordering.getHistory(1, quiet) <= MoveOrdering::HISTORY_MAX);
+    assert(ordering.getKiller(5, 0) == quiet && ordering.getKiller(5, 1) != quiet);
+
+    // The picker yields the legal staged moves first without generating,
+    // then every other move once, best first
+    HexukiBitboard board;
+    board.makeMove(Move(6, 5));
+    MoveGenerator generator(board);
+    [[maybe_unused]] size_t total = generator.count();
+    Move staged[] = {Move(7, 4), Move(0, 9), Move(7, 4)};  // Legal, not adjacent, duplicate
+    auto score = [](const Move& move) { return minimax::staticMoveScore(move); };
+    minimax::MovePicker picker(generator, staged, 3, score);
+    Move move;
+    assert(picker.next(move) && move == Move(7, 4) && !picker.generatedRest());
+    std::unordered_set<int> seen = {move.hexId * 16 + move.tileValue};
+    [[maybe_unused]] int last = 1 << 30;
+    while (picker.next(move)) {
+        assert(picker.generatedRest());
+        assert(board.isValidMove(move));
+        assert(seen.insert(move.hexId * 16 + move.tileValue).second);
+        assert(minimax::staticMoveScore(move) <= last);
+        last = minimax::staticMoveScore(move);
+    }
+    assert(seen.size() == total && picker.picked() == static_cast<int>(total));
+    assert(picker.pickedMoves()[0] == Move(7, 4));
+
+    // Ordering changes the tree, never the endgame score
+    std::mt19937 rng(21);
+    for (int game = 0; game < 3; game++) {
+        HexukiBitboard endgame;
+        for (int ply = 0; ply < 10; ply++) {
+            MoveList moves;
+            endgame.generateMoves(moves);
+            endgame.makeMove(moves[rng() % moves.size()]);
+        }
+        minimax::TranspositionTable tt(4);
+        minimax::SearchConfig config;
+        config.maxDepth = MAX_PLIES;
+        config.tt = &tt;
+        minimax::SearchResult learned = minimax::findBestMove(endgame, config);
+        config.useSearchHeuristics = false;
+        tt.clear();
+        minimax::SearchResult fixed = minimax::findBestMove(endgame, config);
+        assert(learned.score == fixed.score);
+        config.useSearchHeuristics = true;
+        config.useEnhancedTranspositionCutoffs = true;
+        tt.clear();
+        minimax::SearchResult etc = minimax::findBestMove(endgame, config);
+        assert(etc.score == learned.score);
+        assert(learned.cutoffs > 0 && learned.firstMoveCutoffs <= learned.cutoffs);
+        assert(learned.firstMoveCutoffRate() > 0.5);
+    }
+
+    std::cout << "✓ Move ordering test passed\n";
+}
+
+void testScoreBounds() {
+    // Every score a game reaches later lies inside the bounds of each
+    // position before it; a full board's bounds are its score
+    std::mt19937 rng(23);
+    for (int game = 0; game < 200; game++) {
+        HexukiBitboard board;
+        if (game % 4 == 3) {  // Duplicate-tile hands
+            board.setAvailableTiles(PLAYER_1, {9, 9, 9, 9, 1, 1, 1, 1, 1});
+            board.setAvailableTiles(PLAYER_2, {2, 2, 2, 2, 2, 8, 8, 8, 8});
+        }
+        std::vector<ScoreBounds> history;
+        while (!board.isGameOver()) {
+            ScoreBounds bounds = board.getScoreBounds();
+            for (int p = PLAYER_1; p <= PLAYER_2; p++) {
+                assert(bounds.lower[p - 1] == board.getScore(p));
+                assert(bounds.lower[p - 1] <= bounds.upper[p - 1]);
+            }
+            history.push_back(bounds);
+            MoveList moves;
+            board.generateMoves(moves);
+            if (moves.empty()) break;
+            board.makeMove(moves[rng() % moves.size()]);
+        }
+        [[maybe_unused]] int p1 = board.getScore(PLAYER_1);
+        [[maybe_unused]] int p2 = board.getScore(PLAYER_2);
+        for (const ScoreBounds& bounds : history) {
+            assert(bounds.lower[0] <= p1 && p1 <= bounds.upper[0]);
+            assert(bounds.lower[1] <= p2 && p2 <= bounds.upper[1]);
+            assert(bounds.marginLower(PLAYER_1) <= p1 - p2 && p1 - p2 <= bounds.marginUpper(PLAYER_1));
+            if (bounds.decidedWinner() != 0) assert(bounds.decidedWinner() == (p1 > p2 ? PLAYER_1 : PLAYER_2));
+        }
+        if (board.getOccupiedMask() == (1u << NUM_HEXES) - 1) {
+            [[maybe_unused]] ScoreBounds final = board.getScoreBounds();
+            assert(final.lower[0] == final.upper[0] && final.lower[1] == final.upper[1]);
+        }
+    }
+
+    // Bound cutoffs change the tree, never the score (solved and depth-limited)
+    for (int game = 0; game < 4; game++) {
+        HexukiBitboard endgame;
+        for (int ply = 0; ply < 9; ply++) {
+            MoveList moves;
+            endgame.generateMoves(moves);
+            endgame.makeMove(moves[rng() % moves.size()]);
+        }
+        minimax::TranspositionTable tt(4);
+        minimax::SearchConfig config;
+        config.maxDepth = (game % 2) ? 4 : MAX_PLIES;
+        config.tt = &tt;
+        minimax::SearchResult bounded = minimax::findBestMove(endgame, config);
+        config.useScoreBounds = false;
+        tt.clear();
+        minimax::SearchResult plain = minimax::findBestMove(endgame, config);
+        assert(bounded.score == plain.score);
+    }
+
+    std::cout << "✓ Score bounds test passed\n";
+}
+
+void testOutcomeSolver() {
+    // The outcome is the sign of the exact solved score, from either side,
+    // with the solver's entries sharing a table with score searches
+    std::mt19937 rng(24);
+    minimax::TranspositionTable shared(8);
+    int outcomes[3] = {0, 0, 0};
+    for (int game = 0; game < 40; game++) {
+        HexukiBitboard board;
+        if (game % 5 == 4) {  // Identical hands: draws are possible
+            board.setAvailableTiles(PLAYER_1, {1, 1, 1, 1, 1, 1, 1, 1, 1});
+            board.setAvailableTiles(PLAYER_2, {1, 1, 1, 1, 1, 1, 1, 1, 1});
+        }
+        int plies = 10 + game % 4;
+        for (int ply = 0; ply < plies && !board.isGameOver(); ply++) {
+            MoveList moves;
+            board.generateMoves(moves);
+            if (moves.empty()) break;
+            board.makeMove(moves[rng() % moves.size()]);
+        }
+        std::string before = board.savePosition();
+
+        minimax::TranspositionTable tt(4);
+        int64_t nodes = 0;
+        int score = minimax::alphaBeta(board, MAX_PLIES, -1000000, 1000000, tt, nodes,
+                                       std::chrono::steady_clock::now(), 600000);
+        minimax::Outcome expected = score > 0 ? minimax::Outcome::WIN
+                                  : (score < 0 ? minimax::Outcome::LOSS : minimax::Outcome::DRAW);
+
+        [[maybe_unused]] int64_t solverNodes = 0;
+        assert(minimax::solveOutcome(board, shared, solverNodes) == expected);
+        assert(minimax::solveOutcome(board) == expected);
+        assert(solverNodes > 0 && (expected == minimax::Outcome::DRAW || solverNodes < nodes));
+        assert(board.savePosition() == before);
+        outcomes[static_cast<int>(expected) + 1]++;
+
+        // Score searches still work on the table the solver filled
+        shared.newSearch();
+        minimax::SearchConfig config;
+        config.maxDepth = MAX_PLIES;
+        config.tt = &shared;
+        assert(minimax::findBestMove(board, config).score == score);
+    }
+    assert(outcomes[0] > 0 && outcomes[1] > 0 && outcomes[2] > 0);
+
+    std::cout << "✓ Outcome solver test passed\n";
+}
+
+void testEndgameSolver() {
+    // The kernel agrees with a plain search to the end of the game, within
+    // any window (fail-soft bounds outside it), under every rule set
+    std::mt19937 rng(25);
+    int solved = 0;
+    for (int game = 0; game < 120; game++) {
+        HexukiBitboard board;
+        board.setRuleFlags(static_cast<uint8_t>(game % (ALL_RULE_FLAGS + 1)));
+        board.reset();
+        int empty = 1 + game % minimax::ENDGAME_MAX_PLIES;
+        while (NUM_HEXES - BitOps::popcount(board.getOccupiedMask()) > empty) {
+            MoveList moves;
+            board.generateMoves(moves);
+            if (moves.empty()) break;
+            board.makeMove(moves[rng() % moves.size()]);
+        }
+        if (NUM_HEXES - BitOps::popcount(board.getOccupiedMask()) > empty) continue;  // Ended early
+
+        minimax::SearchConfig config;
+        config.maxDepth = MAX_PLIES;
+        config.ttSizeMB = 1;
+        config.endgamePlies = 0;
+        int exact = minimax::findBestMove(board, config).score;
+        solved++;
+        int64_t kernelNodes = 0;
+        assert(minimax::solveEndgame(board, -1000000, 1000000, kernelNodes) == exact);
+        assert(kernelNodes > 0);
+
+        int alpha = exact - 50 + static_cast<int>(rng() % 100);
+        int beta = alpha + 1 + static_cast<int>(rng() % 40);
+        int bounded = minimax::solveEndgame(board, alpha, beta, kernelNodes);
+        if (bounded <= alpha) assert(exact <= bounded);
+        else if (bounded >= beta) assert(exact >= bounded);
+        else assert(bounded == exact);
+    }
+    assert(solved > 60);
+
+    // Searches that hand off to it find the same scores
+    for (int game = 0; game < 4; game++) {
+        HexukiBitboard endgame;
+        if (game % 2) endgame.setAntiSymmetry(true);
+        for (int ply = 0; ply < 9; ply++) {
+            MoveList moves;
+            endgame.generateMoves(moves);
+            endgame.makeMove(moves[rng() % moves.size()]);
+        }
+        minimax::SearchConfig config;
+        config.maxDepth = MAX_PLIES;
+        config.ttSizeMB = 4;
+        minimax::SearchResult kernel = minimax::findBestMove(endgame, config);
+        config.endgamePlies = 0;
+        minimax::SearchResult plain = minimax::findBestMove(endgame, config);
+        assert(kernel.score == plain.score);
+    }
+
+    std::cout << "✓ Endgame solver test passed\n";
+}
+
+void testBoardBatch() {
+    // Follow every lane with a scalar board: each ply must be a legal move,
+    // and the final chain scores must match
+    // (the puzzle runs P1 out of tiles while P2 still has some: lanes must stop there)
+    const char* starts[] = {"", "h9:1,h4:3,h6:5|p1:2,7,8,9|p2:1,1,4,5,6,6,6,9|turn:2"};
+    for (const char* start : starts) {
+        HexukiBitboard board;
+        if (*start) board.loadPosition(start);
+
+        BoardBatch<16> batch;
+        BoardBatch<16> reference;
+        batch.load(board, 1234);
+        reference.load(board, 1234);
+        std::vector<HexukiBitboard> lanes(16, board);
+
+        while (true) {
+            bool moved = batch.step();
+            [[maybe_unused]] bool referenceMoved = reference.stepScalar();
+            assert(moved == referenceMoved);
+            if (!moved) break;
+
+            for (int lane = 0; lane < 16; lane++) {
+                uint32_t placed = batch.getOccupiedMask(lane) & ~lanes[lane].getOccupiedMask();
+                assert(batch.getOccupiedMask(lane) == reference.getOccupiedMask(lane));
+                if (!placed) continue;
+                int hexId = BitOps::countTrailingZeros(placed);
+                Move move(hexId, batch.getTileValue(lane, hexId));
+                assert(lanes[lane].isValidMove(move));
+                lanes[lane].makeMove(move);
+                for (int v = 1; v <= MAX_TILE_VALUE; v++) {
+                    assert(batch.getTileCount(lane, PLAYER_1, v) == lanes[lane].getTileCount(PLAYER_1, v));
+                    assert(batch.getTileCount(lane, PLAYER_2, v) == lanes[lane].getTileCount(PLAYER_2, v));
+                }
+            }
+        }
+
+        int32_t p1[16];
+        int32_t p2[16];
+        double results[16];
+        batch.computeScores(p1, p2);
+        [[maybe_unused]] double total = batch.evaluateTerminal(results);
+        double expected = 0.0;
+        for (int lane = 0; lane < 16; lane++) {
+            assert(lanes[lane].getValidMoves().empty());
+            assert(p1[lane] == lanes[lane].getScore(PLAYER_1));
+            assert(p2[lane] == lanes[lane].getScore(PLAYER_2));
+            expected += results[lane];
+        }
+        assert(total == expected);
+    }
+
+    std::cout << "✓ Board batch test passed (" << (BoardBatch<8>::hasSimdKernel() ? "AVX2" : "scalar") << " kernel)\n";
+}
+
+void testRuleVariants() {
+    assert(RuleRegistry::find("standard") != nullptr);
+    assert(RuleRegistry::find("no-such-variant") == nullptr);
+
+    [[maybe_unused]] const uint64_t standardHash = HexukiBitboard().getHash();
+    std::mt19937 rng(99);
+
+    for (int i = 0; i < RuleRegistry::count(); i++) {
+        const RuleVariant& variant = RuleRegistry::get(i);
+        assert(RuleRegistry::find(variant.name) == &variant);
+
+        HexukiBitboard board;
+        variant.setup(board, 7);
+        assert(board.getRuleFlags() == variant.flags);
+        assert(board.getHash() == Zobrist::hash(board));
+        assert((board.getHash() == standardHash) == (variant.flags == DEFAULT_RULE_FLAGS && !variant.randomTiles));
+        assert(board.getOccupiedMask() == startingOccupancy(variant.flags));
+        assert(board.getAvailableTiles(PLAYER_1).size() == NUM_TILES_PER_PLAYER);
+        assert(board.getAvailableTiles(PLAYER_2).size() == NUM_TILES_PER_PLAYER);
+
+        // Opening: free openings may use any empty hex
+        if (hasFreeOpening(variant.flags)) {
+            assert(board.getLegalHexMask() == (ALL_HEXES_MASK & ~board.getOccupiedMask()));
+        }
+
+        // Random games: the specialized generator matches the runtime-flag one
+        for (int game = 0; game < 20; game++) {
+            HexukiBitboard g = board;
+            while (true) {
+                assert(g.getLegalHexMask() == g.computeLegalHexMask());
+                MoveGenerator generic(g);
+                int count = dispatchRules(g.getRuleFlags(), [&](auto rules) {
+                    MoveGenerator specialized(g, rules);
+                    assert(specialized.getHexMask() == generic.getHexMask());
+                    return specialized.count();
+                });
+                assert(count == generic.count());
+                if (count == 0) break;
+                Move move = generic.random(rng);
+                assert(g.isValidMove(move));
+                g.makeMove(move);
+            }
+        }
+
+        // Search runs the matching specialization
+        minimax::TranspositionTable tt(1);
+        int64_t nodes = 0;
+        minimax::alphaBeta(board, 2, -1000000, 1000000, tt, nodes, std::chrono::steady_clock::now(), 30000);
+        assert(nodes > 1);
+    }
+
+    // Same placements, different chain rule: adjacency-only allows more
+    HexukiBitboard chained;
+    chained.loadPosition("h9:1,h4:2,h14:3|p1:4,5,6|p2:7,8,9|turn:1");
+    HexukiBitboard unchained = chained;
+    unchained.setRuleFlags(RULE_CENTER_START);
+    assert((chained.getLegalHexMask() & ~unchained.getLegalHexMask()) == 0);
+    assert(unchained.getLegalHexMask() == LegalMaskTable::computeAdjacentHexMask(unchained.getOccupiedMask()));
+    assert(chained.getHash() != unchained.getHash());
+
+    // Random deals are reproducible from the seed
+    const RuleVariant* asymmetric = RuleRegistry::find("asymmetric");
+    HexukiBitboard a;
+    HexukiBitboard b;
+    asymmetric->setup(a, 42);
+    asymmetric->setup(b, 42);
+    assert(a.getTileInventory(PLAYER_1) == b.getTileInventory(PLAYER_1));
+    assert(a.getTileInventory(PLAYER_2) == b.getTileInventory(PLAYER_2));
+    assert(!a.isAntiSymmetryEnabled());  // The asymmetric JS engine has no mirror rule
+
+    std::cout << "✓ Rule variants test passed (" << RuleRegistry::count() << " variants)\n";
+}
+
+void testPackedPosition() {
+    assert(sizeof(PackedPosition) == 16);
+
+    // Every position of random games round-trips, hash and scores included
+    std::mt19937 rng(5);
+    std::unordered_set<PackedPosition> seen;
+    int positions = 0;
+    for (int game = 0; game < 50; game++) {
+        HexukiBitboard board;
+        if (game % 2) board.setAntiSymmetry(true);
+        while (true) {
+            PackedPosition packed = board.pack();
+            HexukiBitboard copy;
+            copy.unpack(packed);
+            assert(copy.pack() == packed);
+            assert(copy.savePosition() == board.savePosition());
+            assert(copy.getHash() == Zobrist::hash(board));  // Full recompute (inventory keys)
+            assert(copy.getScore(PLAYER_1) == board.getScore(PLAYER_1));
+            assert(copy.getScore(PLAYER_2) == board.getScore(PLAYER_2));
+            assert(copy.getRuleFlags() == board.getRuleFlags());
+            assert(PackedPosition::fromHex(packed.toHex()) == packed);
+            seen.insert(packed);
+            positions++;
+
+            MoveGenerator moves(board);
+            if (moves.empty()) break;
+            board.makeMove(moves.random(rng));
+        }
+    }
+    assert(seen.size() > 1 && static_cast<int>(seen.size()) <= positions);
+
+    // Duplicate-heavy puzzle hands and ordering
+    HexukiBitboard puzzle;
+    puzzle.loadPosition("h9:1,h4:5|p1:1,1,1,1,1,1,1,1,1|p2:9,9,2|turn:2");
+    HexukiBitboard copy;
+    copy.unpack(puzzle.pack());
+    assert(copy.getTileCount(PLAYER_1, 1) == 9);
+    assert(copy.getTileCount(PLAYER_2, 9) == 2);
+    assert(copy.getCurrentPlayer() == PLAYER_2);
+    assert(copy.savePosition() == puzzle.savePosition());
+
+    [[maybe_unused]] PackedPosition a = HexukiBitboard().pack();
+    [[maybe_unused]] PackedPosition b = puzzle.pack();
+    assert((a < b) != (b < a));
+    assert(a != b);
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        PackedPosition::fromHex("not-a-position");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Packed position test passed (" << seen.size() << " distinct positions)\n";
+}
+
+void testNotation() {
+    Move move;
+    assert(parseMove("h6t5", move).ok() && move == Move(6, 5));
+    assert(parseMove("h18t9", move).ok() && move == Move(18, 9));
+
+    ParseStatus status = parseMove("h19t5", move);
+    assert(!status.ok() && status.offset == 1);  // Hex out of range
+    status = parseMove("h6x5", move);
+    assert(!status.ok() && status.offset == 2);
+    assert(!parseMove("h6t0", move).ok());
+    assert(!parseMove("h6t5 ", move).ok());
+    assert(!parseMove("", move).ok());
+
+    // Positions load the same as they save, including puzzles without the center
+    const char* positions[] = {
+        "h9:1,h4:5,h6:3|p1:2,4,8|p2:6,7,9|turn:2",
+        "h4:9,h6:9,h14:9,h16:9|p1:3,3,3,8,8,8,1,1|p2:3,3,3,3,3,3,3|turn:1",
+        "h9:1|p1:|p2:1|turn:1",
+    };
+    for (const char* text : positions) {
+        HexukiBitboard board;
+        [[maybe_unused]] bool ok = board.loadPosition(text);
+        assert(ok);
+        assert(board.getHash() == Zobrist::hash(board));
+        HexukiBitboard reloaded;
+        ok = reloaded.loadPosition(board.savePosition());
+        assert(ok);
+        assert(reloaded.pack() == board.pack());
+    }
+
+    // Defaults: full hands, player 1 to move
+    PackedPosition packed;
+    assert(parsePosition("h9:1", packed).ok());
+    assert(packed == HexukiBitboard().pack());
+
+    // Errors point at the problem and leave the board alone
+    assert(parsePosition("h9:1|p1:2,x|turn:1", packed).offset == 10);
+    assert(!parsePosition("h9:1|turn:3", packed).ok());
+    assert(!parsePosition("h9:1|p1:1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1", packed).ok());
+    assert(!parsePosition("h9:1|moves:3", packed).ok());
+    HexukiBitboard board;
+    board.makeMove(Move(4, 7));
+    [[maybe_unused]] PackedPosition before = board.pack();
+    assert(!board.loadPosition("h9:10|turn:1"));
+    assert(board.pack() == before && board.getPly() == 1);
+
+    // Bulk: CRLF, blank lines and a bad line in the middle
+    std::string buffer =
+        "h9:1|p1:2,3|p2:4,5|turn:1\r\n"
+        "\n"
+        "h9:1,h4:oops\n"
+        "h9:1,h4:3|p1:2|p2:4,5|turn:2";
+    std::vector<PackedPosition> packedPositions;
+    std::vector<LineParseError> errors;
+    assert(parsePositions(buffer, packedPositions, &errors) == 2);
+    assert(errors.size() == 1 && errors[0].line == 3);
+
+    std::vector<HexukiBitboard> boards;
+    assert(parsePositions(buffer, boards) == 2);
+    assert(boards[1].getCurrentPlayer() == PLAYER_2 && boards[1].getTileValue(4) == 3);
+    assert(boards[1].pack() == packedPositions[1]);
+    assert(boards[1].getHash() == Zobrist::hash(boards[1]));
+
+    std::cout << "✓ Notation parser test passed\n";
+}
+
+void testMoveHistory() {
+    // Random games: history, notation round trip, multi-level undo
+    std::mt19937 rng(11);
+    for (int game = 0; game < 20; game++) {
+        HexukiBitboard board;
+        if (game % 2) board.setAntiSymmetry(true);
+        const PackedPosition start = board.pack();
+        std::vector<PackedPosition> positions{start};
+        std::vector<Move> played;
+        while (true) {
+            MoveGenerator moves(board);
+            if (moves.empty()) break;
+            Move move = moves.random(rng);
+            board.makeMove(move);
+            played.push_back(move);
+            positions.push_back(board.pack());
+        }
+
+        assert(board.getPly() == static_cast<int>(played.size()));
+        for (int ply = 0; ply < board.getPly(); ply++) {
+            assert(board.getMove(ply) == played[ply]);
+        }
+        assert(board.getMove(board.getPly()) == Move());
+
+        std::string notation = board.toNotation();
+        assert(notation.find(':') == std::string::npos);  // Standard start: moves only
+        HexukiBitboard replay;
+        replay.setRuleFlags(board.getRuleFlags());
+        [[maybe_unused]] bool ok = replay.fromNotation(notation);
+        assert(ok);
+        assert(replay.pack() == board.pack() && replay.getPly() == board.getPly());
+        assert(replay.toNotation() == notation);
+
+        int ply = static_cast<int>(rng() % (played.size() + 1));
+        board.undoToPly(ply);
+        assert(board.getPly() == ply && board.pack() == positions[ply]);
+        board.unmakeMoves(100);
+        assert(board.getPly() == 0 && board.pack() == start);
+    }
+
+    // Puzzle start: the record carries the starting position
+    HexukiBitboard puzzle;
+    puzzle.loadPosition("h9:1,h4:3|p1:2,5,7|p2:1,1,6|turn:2");
+    puzzle.makeMove(Move(6, 6));
+    puzzle.makeMove(Move(7, 5));
+    std::string record = puzzle.toNotation();
+    assert(record == "h4:3,h9:1|p1:2,5,7|p2:1,1,6|turn:2 h6t6 h7t5");
+    HexukiBitboard replay;
+    [[maybe_unused]] bool ok = replay.fromNotation(record);
+    assert(ok);
+    assert(replay.pack() == puzzle.pack() && replay.getPly() == 2);
+
+    // Bad records leave the board alone
+    [[maybe_unused]] PackedPosition before = replay.pack();
+    assert(!replay.fromNotation("h6t5 h6t4"));   // Hex taken
+    assert(!replay.fromNotation("h6t5 banana"));
+    [[maybe_unused]] ParseStatus status = parseGame("h6t5  h0t9", replay);
+    assert(!status.ok() && status.offset == 6);  // Not adjacent
+    assert(replay.pack() == before && replay.getPly() == 2);
+
+    std::cout << "✓ Move history test passed\n";
+}
+
+void testChainLengthConstraint() {
+    HexukiBitboard board;
+    board.loadPosition("h9:1,h4:3|p1:1,2,3,4,5,6,7,8,9|p2:1,2,4,5,6,7,8,9|turn:1");
+
+    // Extending the center column to 3 would be 2 longer than every other chain
+    assert(!board.isValidMove(Move(14, 5)));
+    assert(!board.isValidMove(Move(0, 5)));
+    assert(board.isValidMove(Move(6, 5)));
+
+    // Incremental runs must match after make/unmake
+    board.makeMove(Move(6, 5));
+    board.makeMove(Move(7, 4));
+    assert(board.isValidMove(Move(14, 2)));  // Second longest is now 2
+    board.unmakeMove(Move(7, 4));
+    board.unmakeMove(Move(6, 5));
+    assert(!board.isValidMove(Move(14, 5)));
+
+    std::cout << "✓ Chain length constraint test passed\n";
+}
+
+void testLegalHexMask() {
+    HexukiBitboard board;
+
+    // Opening: the 6 hexes around the center
+    assert(board.getLegalHexMask() == HEX_NEIGHBOR_MASKS[CENTER_HEX]);
+    assert(board.getLegalHexMask() == board.computeLegalHexMask());
+
+    // Table must agree with the rule walk for every occupancy
+    for (uint32_t occ = 0; occ < LegalMaskTable::NUM_OCCUPANCIES; occ++) {
+        assert(LegalMaskTable::lookup(occ) == LegalMaskTable::computeLegalHexMask(occ));
+        assert((LegalMaskTable::lookup(occ) & occ) == 0);
+    }
+
+    std::cout << "✓ Legal hex mask test passed\n";
+}
+
+void testHexGeometry() {
+    // Neighbor masks must match the row/col adjacency rules
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        uint32_t expected = 0;
+        for (int other = 0; other < NUM_HEXES; other++) {
+            int dr = HEX_POSITIONS[other].row - HEX_POSITIONS[hexId].row;
+            int dc = HEX_POSITIONS[other].col - HEX_POSITIONS[hexId].col;
+            for (int d = 0; d < NUM_DIRECTIONS; d++) {
+                if (HEX_DIRECTIONS[d].dr == dr && HEX_DIRECTIONS[d].dc == dc) {
+                    expected |= (1u << other);
+                }
+            }
+        }
+        assert(HEX_NEIGHBOR_MASKS[hexId] == expected);
+    }
+
+    // Lines cover every hex exactly three times
+    int coverage[NUM_HEXES] = {};
+    for (int line = 0; line < NUM_LINES; line++) {
+        assert(LINE_HEXES[line][0] == CHAIN_STARTERS[line].startHex);
+        for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+            if (LINE_MASKS[line] & (1u << hexId)) coverage[hexId]++;
+        }
+    }
+    for (int hexId = 0; hexId < NUM_HEXES; hexId++) {
+        assert(coverage[hexId] == LINES_PER_HEX);
+    }
+
+    // P1 chains are the down-right lines
+    assert(LINE_HEXES[8][4] == P1_CHAINS[2][4]);
+
+    std::cout << "✓ Hex geometry test passed\n";
+}
+
+// Chain scores of a HexBoard recomputed from the generated chain tables
+template <int Radius>
+int64_t recomputeScore(const HexBoard<Radius>& board, int player) {
+    using Geometry = HexGeometry<Radius>;
+    const auto& chains = (player == PLAYER_1) ? Geometry::P1_CHAINS : Geometry::P2_CHAINS;
+    int64_t score = 0;
+    for (const auto& chain : chains) {
+        int64_t product = 1;
+        for (int hexId : chain) {
+            if (hexId >= 0 && board.getTileValue(hexId)) product *= board.getTileValue(hexId);
+        }
+        score += product;
+    }
+    return score;
+}
+
+template <int Radius>
+void checkLargeBoard([[maybe_unused]] int expectedHexes) {
+    using Geometry = HexGeometry<Radius>;
+    assert(Geometry::NUM_HEXES == expectedHexes);
+
+    // Every hex lies on one line per axis and one chain per player
+    int lineCoverage[Geometry::NUM_HEXES] = {};
+    int chainCoverage[Geometry::NUM_HEXES] = {};
+    for (int line = 0; line < Geometry::NUM_LINES; line++) {
+        for (int hexId = 0; hexId < Geometry::NUM_HEXES; hexId++) {
+            for (int axis = 0; axis < 3; axis++) {
+                if (Geometry::HEX_LINES[hexId][axis] == line) lineCoverage[hexId]++;
+            }
+        }
+    }
+    for (int c = 0; c < Geometry::CHAINS_PER_PLAYER; c++) {
+        for (int i = 0; i < Geometry::P1_CHAIN_LENGTHS[c]; i++) chainCoverage[Geometry::P1_CHAINS[c][i]]++;
+        for (int i = 0; i < Geometry::P2_CHAIN_LENGTHS[c]; i++) chainCoverage[Geometry::P2_CHAINS[c][i]]++;
+    }
+    for (int hexId = 0; hexId < Geometry::NUM_HEXES; hexId++) {
+        assert(lineCoverage[hexId] == 3);
+        assert(chainCoverage[hexId] == 2);
+        assert(Geometry::VERTICAL_MIRROR_PAIRS[Geometry::VERTICAL_MIRROR_PAIRS[hexId]] == hexId);
+    }
+    assert(Geometry::P1_CHAIN_LENGTHS[Radius] == 2 * Radius + 1);  // Center diagonal
+    assert(Geometry::VERTICAL_MIRROR_PAIRS[Geometry::CENTER_HEX] == Geometry::CENTER_HEX);
+
+    // Random games: incremental scores and hash match a recompute, unmake restores the start
+    std::mt19937 rng(Radius);
+    for (int game = 0; game < 20; game++) {
+        HexBoard<Radius> board;
+        [[maybe_unused]] uint64_t startHash = board.getHash();
+        int plies = board.playout(rng);
+        assert(plies == board.getPly() && plies > 0);
+        assert(board.getHash() == board.computeHash());
+        assert(board.getScore(PLAYER_1) == recomputeScore(board, PLAYER_1));
+        assert(board.getScore(PLAYER_2) == recomputeScore(board, PLAYER_2));
+        for (int ply = 0; ply < plies; ply++) board.unmakeMove();
+        assert(board.getHash() == startHash);
+        assert(board.getOccupiedMask() == (typename Geometry::Mask(1) << Geometry::CENTER_HEX));
+    }
+}
+
+void testHexBoard() {
+    // HexBoard<2> must play exactly the 19-hex game
+    const uint8_t flagSets[] = {
+        DEFAULT_RULE_FLAGS,
+        DEFAULT_RULE_FLAGS | RULE_ANTI_SYMMETRY,
+        RULE_CENTER_START | RULE_FREE_OPENING | RULE_CHAIN_CONSTRAINT,
+        0,
+    };
+    std::mt19937 rng(15);
+    for (uint8_t flags : flagSets) {
+        for (int game = 0; game < 50; game++) {
+            HexukiBitboard board;
+            board.setRuleFlags(flags);
+            board.reset();
+            HexBoard<2> generic(flags);
+
+            while (true) {
+                assert(generic.getOccupiedMask() == board.getOccupiedMask());
+                assert(generic.getLegalHexMask() == board.getLegalHexMask());
+                assert(generic.getScore(PLAYER_1) == board.getScore(PLAYER_1));
+                assert(generic.getScore(PLAYER_2) == board.getScore(PLAYER_2));
+                assert(generic.getHash() == Zobrist::hash(board));
+
+                std::vector<Move> moves = board.getValidMoves();
+                assert(generic.getValidMoves() == moves);
+                if (moves.empty()) break;
+
+                Move move = moves[rng() % moves.size()];
+                board.makeMove(move);
+                generic.makeMove(move);
+            }
+        }
+    }
+
+    // Larger boards: 37 and 61 hexes (uint64_t masks)
+    static_assert(std::is_same<HexBoard<3>::Mask, uint64_t>::value, "37 hexes need 64-bit masks");
+    checkLargeBoard<3>(37);
+    checkLargeBoard<4>(61);
+
+    std::cout << "✓ HexBoard (37/61-hex boards) test passed\n";
+}
+
+// Reference leaf count through getValidMoves
+uint64_t naivePerft(HexukiBitboard& board, int depth) {
+    if (depth == 0) return 1;
+    uint64_t nodes = 0;
+    for (const Move& move : board.getValidMoves()) {
+        board.makeMove(move);
+        nodes += naivePerft(board, depth - 1);
+        board.unmakeMove();
+    }
+    return nodes;
+}
+
+void testPerft() {
+    HexukiBitboard board;
+
+    // Regression values for the standard start position
+    assert(perft(board, 1) == 54);
+    assert(perft(board, 2) == 2916);
+    assert(perft(board, 3) == 209952);
+
+    // Bulk and full counting agree with the reference, under other rules too
+    const uint8_t flagSets[] = {DEFAULT_RULE_FLAGS, DEFAULT_RULE_FLAGS | RULE_ANTI_SYMMETRY, 0};
+    for (uint8_t flags : flagSets) {
+        HexukiBitboard variant;
+        variant.setRuleFlags(flags);
+        variant.reset();
+        variant.makeMove(variant.getValidMoves()[7]);
+        for (int depth = 0; depth <= 2; depth++) {
+            [[maybe_unused]] uint64_t expected = naivePerft(variant, depth);
+            assert(perft(variant, depth, true) == expected);
+            assert(perft(variant, depth, false) == expected);
+        }
+    }
+
+    // Threaded divide: one entry per root move, summing to the total
+    PerftOptions options;
+    options.depth = 3;
+    options.threads = 3;
+    PerftResult result = runPerft(board, options);
+    assert(result.nodes == 209952);
+    assert(result.divide.size() == board.getValidMoves().size());
+    uint64_t sum = 0;
+    for (size_t i = 0; i < result.divide.size(); i++) {
+        assert(result.divide[i].move == board.getValidMoves()[i]);
+        HexukiBitboard child = board;
+        child.makeMove(result.divide[i].move);
+        assert(result.divide[i].nodes == perft(child, 2));
+        sum += result.divide[i].nodes;
+    }
+    assert(sum == result.nodes);
+
+    // Unique positions: transpositions merge, symmetric positions merge further
+    options.depth = 2;
+    options.unique = PerftKey::HASH;
+    PerftResult byHash = runPerft(board, options);
+    std::set<PackedPosition> expected;  // Exact positions: the 128-bit keys must not merge any
+    for (const Move& first : board.getValidMoves()) {
+        HexukiBitboard child = board;
+        child.makeMove(first);
+        for (const Move& second : child.getValidMoves()) {
+            HexukiBitboard leaf = child;
+            leaf.makeMove(second);
+            expected.insert(leaf.pack());
+        }
+    }
+    assert(byHash.nodes == 2916);
+    assert(byHash.uniquePositions == expected.size());
+
+    options.unique = PerftKey::CANONICAL;
+    PerftResult byCanonical = runPerft(board, options);
+    assert(byCanonical.uniquePositions < byHash.uniquePositions);
+
+    std::cout << "✓ Perft test passed\n";
+}
+
 void testGameOver() {
     HexukiBitboard board;
 
@@ -178,11 +1424,34 @@ int main() {
     testBitboardCreation();
     testMoveParsing();
     testMoveGeneration();
+    testMoveGenerator();
     testTileAvailability();
     testMakingMoves();
     testUnmakeMove();
     testChainScoring();
+    testIncrementalScoring();
     testAntiSymmetry();
+    testAntiSymmetryRule();
+    testUndoStack();
+    testSymmetricHashing();
+    testIncrementalHashing();
+    testTranspositionTable();
+    testLazySmp();
+    testPrincipalVariation();
+    testMoveOrdering();
+    testScoreBounds();
+    testOutcomeSolver();
+    testEndgameSolver();
+    testBoardBatch();
+    testRuleVariants();
+    testPackedPosition();
+    testNotation();
+    testMoveHistory();
+    testChainLengthConstraint();
+    testLegalHexMask();
+    testHexGeometry();
+    testHexBoard();
+    testPerft();
     testGameOver();
 
     std::cout << "\n===========================================\n";
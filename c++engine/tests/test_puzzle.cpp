@@ -161,6 +161,36 @@ void testEmptyBoardPuzzle() {
     std::cout << "✓ Empty board puzzle works\n";
 }
 
+void testDuplicateTiles() {
+    std::cout << "\nTesting duplicate tile inventory...\n";
+
+    HexukiBitboard board;
+    board.loadPosition("h9:1|p1:3,3,3,3|p2:1,1,2|turn:1");
+
+    assert(board.getTileCount(PLAYER_1, 3) == 4);
+    assert(board.getTileCount(PLAYER_2, 1) == 2);
+    assert(board.getAvailableTiles(PLAYER_2).size() == 3);
+
+    // Duplicates generate one move per hex, not one per copy
+    auto moves = board.getValidMoves();
+    assert(moves.size() == 6);
+
+    // Playing a copy decrements the count, unmake restores it
+    Move move(6, 3);
+    board.makeMove(move);
+    assert(board.getTileCount(PLAYER_1, 3) == 3);
+    board.unmakeMove(move);
+    assert(board.getTileCount(PLAYER_1, 3) == 4);
+
+    // Copies are plain memcpy - mutating a copy leaves the original alone
+    HexukiBitboard copy = board;
+    copy.makeMove(move);
+    assert(board.getTileCount(PLAYER_1, 3) == 4);
+    assert(!board.isHexOccupied(6));
+
+    std::cout << "✓ Duplicate tile inventory works\n";
+}
+
 int main() {
     std::cout << "===========================================\n";
     std::cout << "HEXUKI C++ ENGINE - Puzzle Loading Tests\n";
@@ -172,6 +202,7 @@ int main() {
     testPositionLoadSave();
     testPuzzleSolving();
     testEmptyBoardPuzzle();
+    testDuplicateTiles();
 
     std::cout << "\n===========================================\n";
     std::cout << "✅ All puzzle tests passed!\n";